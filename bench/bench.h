@@ -0,0 +1,83 @@
+#ifndef _CIRCULAR_BENCH_H_
+#define _CIRCULAR_BENCH_H_ 1
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+// Minimal timing harness shared by the benchmarks; nothing outside the
+// standard library is needed. Every result is printed as one JSON object per
+// line on stdout, so runs can be diffed or loaded by a script to track
+// regressions. --quick shrinks the sizes so ctest can smoke-test each binary.
+namespace bench
+{
+	struct options
+	{
+		bool quick;
+		int repeats;
+	};
+
+	inline options parse(int argc,char** argv)
+	{
+		options opt = {false,5};
+		for (int i = 1;i < argc;i++)
+		{
+			if (std::strcmp(argv[i],"--quick") == 0)
+			{
+				opt.quick = true;
+				opt.repeats = 1;
+			}
+		}
+		return opt;
+	}
+
+	// Keeps value alive as far as the optimiser is concerned.
+	template <typename _Tp>
+	  inline void keep(const _Tp& value)
+	{
+#if defined(__GNUC__)
+		asm volatile("" : : "g"(&value) : "memory");
+#else
+		static volatile const void* sink;
+		sink = &value;
+#endif
+	}
+
+	// Best of opt.repeats runs of fn(), in nanoseconds. setup() runs before
+	// each repetition and is not timed.
+	template <typename _Setup,typename _Fn>
+	  inline double best_ns(const options& opt,_Setup setup,_Fn fn)
+	{
+		double best = 0;
+		for (int r = 0;r < opt.repeats;r++)
+		{
+			setup();
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			fn();
+			double ns = std::chrono::duration<double,std::nano>(std::chrono::steady_clock::now() - start).count();
+			if (r == 0 || ns < best) best = ns;
+		}
+		return best;
+	}
+
+	template <typename _Fn>
+	  inline double best_ns(const options& opt,_Fn fn) {return best_ns(opt,[] {},fn);}
+
+	inline void report(const char* suite,const char* name,const char* container,const char* payload,size_t n,size_t ops,double ns)
+	{
+		std::printf("{\"suite\":\"%s\",\"case\":\"%s\",\"container\":\"%s\",\"payload\":\"%s\",\"n\":%zu,\"ops\":%zu,\"ns\":%.0f,\"ns_per_op\":%.3f}\n",suite,name,container,payload,n,ops,ns,ops ? ns / ops : 0.0);
+		std::fflush(stdout);
+	}
+
+	// Fixed-size payload for measuring element size effects.
+	template <size_t _Size>
+	  struct payload
+	{
+		unsigned char bytes[_Size];
+
+		payload() : bytes() {}
+		explicit payload(size_t v) : bytes() {std::memcpy(bytes,&v,_Size < sizeof(v) ? _Size : sizeof(v));}
+	};
+}
+#endif
@@ -0,0 +1,99 @@
+#include <concurrent_circular_queue>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+
+// blocking_circular_queue against the ad hoc version it replaces: a
+// circular_queue behind one mutex with a notify_one per push and per pop.
+// Producers push bursts, consumers park whenever the ring runs dry, so the
+// numbers are dominated by how often the condition variables are touched.
+
+namespace
+{
+	const char* const suite = "blocking_circular_queue";
+
+	struct ad_hoc_queue
+	{
+		std::mutex lock;
+		std::condition_variable not_empty;
+		std::condition_variable not_full;
+		std::circular_queue<size_t> q;
+
+		explicit ad_hoc_queue(size_t cap) : q(cap) {}
+		void push(size_t v)
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			not_full.wait(guard,[this] {return !q.is_full();});
+			q.enqueue(v);
+			guard.unlock();
+			not_empty.notify_one();
+		}
+		void pop(size_t& out)
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			not_empty.wait(guard,[this] {return !q.isEmpty();});
+			out = q.front();
+			q.dequeue();
+			guard.unlock();
+			not_full.notify_one();
+		}
+	};
+
+	struct blocking_queue
+	{
+		std::blocking_circular_queue<size_t> q;
+
+		explicit blocking_queue(size_t cap) : q(cap) {}
+		void push(size_t v) {q.push(v);}
+		void pop(size_t& out) {q.pop(out);}
+	};
+
+	template <typename _Queue>
+	  void pairs(const bench::options& opt,const char* name,unsigned n,size_t total)
+	{
+		size_t per_thread = total / n;
+		double ns = bench::best_ns(opt,[&]
+		{
+			_Queue q(256);
+			std::vector<std::thread> threads;
+			for (unsigned p = 0;p < n;p++)
+			{
+				threads.emplace_back([&q,per_thread]
+				{
+					for (size_t i = 0;i < per_thread;i++)
+					{
+						q.push(i);
+						// Bursts of 64 with a pause between them let consumers park.
+						if (i % 64 == 63) std::this_thread::yield();
+					}
+				});
+				threads.emplace_back([&q,per_thread]
+				{
+					size_t v = 0;
+					for (size_t i = 0;i < per_thread;i++) q.pop(v);
+					bench::keep(v);
+				});
+			}
+			for (std::thread& t : threads) t.join();
+		});
+		bench::report(suite,"producer_consumer_pairs",name,"8B",n,per_thread * n,ns);
+	}
+}
+
+int main(int argc,char** argv)
+{
+	bench::options opt = bench::parse(argc,argv);
+	size_t total = opt.quick ? 20000 : 4000000;
+	unsigned max_pairs = std::max(2u,std::thread::hardware_concurrency() / 2);
+	if (opt.quick) max_pairs = 2;
+	for (unsigned n = 1;n <= max_pairs;n *= 2)
+	{
+		pairs<blocking_queue>(opt,"blocking_circular_queue",n,total);
+		pairs<ad_hoc_queue>(opt,"mutex+condvar+circular_queue",n,total);
+	}
+	return 0;
+}
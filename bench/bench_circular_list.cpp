@@ -0,0 +1,224 @@
+#include <circular_list>
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+
+// circular_list against std::list and std::deque on the operations the list is
+// used for: churn at the ends, insert/erase at an iterator, find, sort,
+// reverse, splice, indexed access and export to a vector.
+
+namespace
+{
+	const char* const suite = "circular_list";
+
+	std::vector<int> random_ints(size_t n,unsigned seed)
+	{
+		std::mt19937 gen(seed);
+		std::vector<int> v(n);
+		for (size_t i = 0;i < n;i++) v[i] = static_cast<int>(gen());
+		return v;
+	}
+
+	template <typename _List>
+	  void churn(const bench::options& opt,const char* name,size_t n)
+	{
+		_List l;
+		size_t ops = n * 8;
+		double ns = bench::best_ns(opt,[&] {l.clear();for (size_t i = 0;i < n;i++) l.push_back(static_cast<int>(i));},[&]
+		{
+			for (size_t i = 0;i < ops;i++)
+			{
+				l.pop_front();
+				l.push_back(static_cast<int>(i));
+			}
+		});
+		bench::keep(l.front());
+		bench::report(suite,"push_back_pop_front",name,"int",n,ops,ns);
+	}
+
+	template <typename _List>
+	  void insert_erase(const bench::options& opt,const char* name,size_t n)
+	{
+		_List l;
+		for (size_t i = 0;i < n;i++) l.push_back(static_cast<int>(i));
+		typename _List::iterator pos = l.begin();
+		std::advance(pos,n / 2);
+		size_t ops = n * 4;
+		double ns = bench::best_ns(opt,[&]
+		{
+			for (size_t i = 0;i < ops;i++)
+			{
+				l.insert(pos,static_cast<int>(i));
+				typename _List::iterator prev = pos;
+				--prev;
+				l.erase(prev);
+			}
+		});
+		bench::keep(l.front());
+		bench::report(suite,"insert_erase",name,"int",n,ops,ns);
+	}
+
+	template <typename _List>
+	  void find(const bench::options& opt,const char* name,size_t n)
+	{
+		std::vector<int> values = random_ints(n,1);
+		_List l(values.begin(),values.end());
+		size_t ops = 64;
+		std::vector<int> targets;
+		for (size_t i = 0;i < ops;i++) targets.push_back(values[(i * 7919) % n]);
+		double ns = bench::best_ns(opt,[&]
+		{
+			for (size_t i = 0;i < ops;i++) bench::keep(*std::find(l.begin(),l.end(),targets[i]));
+		});
+		bench::report(suite,"find",name,"int",n,ops * n,ns);
+	}
+
+	void find_member(const bench::options& opt,size_t n)
+	{
+		std::vector<int> values = random_ints(n,1);
+		std::circular_list<int> l(values.begin(),values.end());
+		size_t ops = 64;
+		std::vector<int> targets;
+		for (size_t i = 0;i < ops;i++) targets.push_back(values[(i * 7919) % n]);
+		double ns = bench::best_ns(opt,[&]
+		{
+			for (size_t i = 0;i < ops;i++) bench::keep(*l.find(targets[i]));
+		});
+		bench::report(suite,"find_member","circular_list","int",n,ops * n,ns);
+	}
+
+	template <typename _List,typename _Sort>
+	  void sort(const bench::options& opt,const char* name,size_t n,const char* order,_Sort do_sort)
+	{
+		std::vector<int> values = random_ints(n,2);
+		if (order[0] == 's') std::sort(values.begin(),values.end());
+		_List l;
+		double ns = bench::best_ns(opt,[&] {l.assign(values.begin(),values.end());},[&] {do_sort(l);});
+		bench::keep(l.front());
+		bench::report(suite,order[0] == 's' ? "sort_sorted" : "sort_random",name,"int",n,n,ns);
+	}
+
+	template <typename _List,typename _Reverse>
+	  void reverse(const bench::options& opt,const char* name,size_t n,_Reverse do_reverse)
+	{
+		std::vector<int> values = random_ints(n,3);
+		_List l(values.begin(),values.end());
+		size_t ops = 16;
+		double ns = bench::best_ns(opt,[&] {for (size_t i = 0;i < ops;i++) do_reverse(l);});
+		bench::keep(l.front());
+		bench::report(suite,"reverse",name,"int",n,ops * n,ns);
+	}
+
+	template <typename _List>
+	  void splice(const bench::options& opt,const char* name,size_t n)
+	{
+		_List a,b;
+		for (size_t i = 0;i < n;i++)
+		{
+			a.push_back(static_cast<int>(i));
+			b.push_back(static_cast<int>(i));
+		}
+		size_t ops = 1 << 16;
+		double ns = bench::best_ns(opt,[&]
+		{
+			for (size_t i = 0;i < ops;i++)
+			{
+				a.splice(a.end(),b);
+				b.splice(b.end(),a);
+			}
+		});
+		bench::keep(b.front());
+		bench::report(suite,"splice_whole",name,"int",n,ops * 2,ns);
+	}
+
+	template <typename _List,typename _At>
+	  void index(const bench::options& opt,const char* name,size_t n,_At at)
+	{
+		_List l;
+		for (size_t i = 0;i < n;i++) l.push_back(static_cast<int>(i));
+		size_t ops = 1024;
+		double ns = bench::best_ns(opt,[&]
+		{
+			int sum = 0;
+			for (size_t i = 0;i < ops;i++) sum += at(l,(i * 7919) % n);
+			bench::keep(sum);
+		});
+		bench::report(suite,"operator_index",name,"int",n,ops,ns);
+	}
+
+	template <typename _List,typename _Export>
+	  void to_vector(const bench::options& opt,const char* name,size_t n,_Export do_export)
+	{
+		std::vector<int> values = random_ints(n,4);
+		_List l(values.begin(),values.end());
+		size_t ops = 16;
+		double ns = bench::best_ns(opt,[&]
+		{
+			for (size_t i = 0;i < ops;i++) bench::keep(do_export(l).back());
+		});
+		bench::report(suite,"to_vector",name,"int",n,ops * n,ns);
+	}
+}
+
+int main(int argc,char** argv)
+{
+	bench::options opt = bench::parse(argc,argv);
+	typedef std::circular_list<int> clist;
+	typedef std::list<int> slist;
+	typedef std::deque<int> sdeque;
+
+	std::vector<size_t> sizes;
+	if (opt.quick) sizes.push_back(1000);
+	else
+	{
+		sizes.push_back(1000);
+		sizes.push_back(100000);
+		sizes.push_back(1000000);
+	}
+
+	for (size_t n : sizes)
+	{
+		churn<clist>(opt,"circular_list",n);
+		churn<slist>(opt,"std::list",n);
+		churn<sdeque>(opt,"std::deque",n);
+
+		insert_erase<clist>(opt,"circular_list",n);
+		insert_erase<slist>(opt,"std::list",n);
+
+		size_t small = n < 100000 ? n : 100000;
+		find<clist>(opt,"circular_list",small);
+		find_member(opt,small);
+		find<slist>(opt,"std::list",small);
+		find<sdeque>(opt,"std::deque",small);
+
+		for (const char* order : {"random","sorted"})
+		{
+			sort<clist>(opt,"circular_list",n,order,[](clist& l) {l.sort();});
+			sort<slist>(opt,"std::list",n,order,[](slist& l) {l.sort();});
+			sort<sdeque>(opt,"std::deque",n,order,[](sdeque& d) {std::stable_sort(d.begin(),d.end());});
+		}
+
+		reverse<clist>(opt,"circular_list",n,[](clist& l) {l.reverse();});
+		reverse<slist>(opt,"std::list",n,[](slist& l) {l.reverse();});
+		reverse<sdeque>(opt,"std::deque",n,[](sdeque& d) {std::reverse(d.begin(),d.end());});
+
+		splice<clist>(opt,"circular_list",n);
+		splice<slist>(opt,"std::list",n);
+
+		size_t indexed = n < 10000 ? n : 10000;
+		index<clist>(opt,"circular_list",indexed,[](clist& l,size_t i) {return l[static_cast<int>(i)];});
+		index<slist>(opt,"std::list",indexed,[](slist& l,size_t i) {return *std::next(l.begin(),static_cast<ptrdiff_t>(i));});
+		index<sdeque>(opt,"std::deque",n,[](sdeque& d,size_t i) {return d[i];});
+
+		to_vector<clist>(opt,"circular_list",n,[](const clist& l) {return l.to_vector();});
+		to_vector<slist>(opt,"std::list",n,[](const slist& l) {return std::vector<int>(l.begin(),l.end());});
+		to_vector<sdeque>(opt,"std::deque",n,[](const sdeque& d) {return std::vector<int>(d.begin(),d.end());});
+	}
+	return 0;
+}
@@ -0,0 +1,50 @@
+#include <circular_list>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+
+// circular_list::partial_sort(k) and nth_element(n) against the full sort()
+// they replace for top-k and median queries, on shuffled int lists. Each
+// repetition rebuilds the list from the same values outside the timed region,
+// on a fresh pool so node placement does not depend on the case run before.
+
+namespace
+{
+	const char* const suite = "circular_list_select";
+
+	typedef std::circular_list<int,std::circular_pool_allocator<int> > clist;
+
+	template <typename _Fn>
+	  void run(const bench::options& opt,const char* name,const std::vector<int>& values,_Fn fn)
+	{
+		std::unique_ptr<clist> l;
+		double ns = bench::best_ns(opt,[&]
+		{
+			l.reset();
+			l.reset(new clist(values.begin(),values.end(),std::circular_pool_allocator<int>(std::make_shared<std::circular_pool_resource>())));
+		},[&] {fn(*l);});
+		bench::keep(l->front());
+		bench::report(suite,name,"circular_list","4B",values.size(),values.size(),ns);
+	}
+}
+
+int main(int argc,char** argv)
+{
+	bench::options opt = bench::parse(argc,argv);
+	const size_t sizes[] = {10000,100000,1000000};
+	for (size_t n : sizes)
+	{
+		if (opt.quick) n /= 100;
+		std::mt19937 gen(static_cast<unsigned>(n));
+		std::vector<int> values(n);
+		for (int& v : values) v = static_cast<int>(gen());
+
+		run(opt,"sort",values,[](clist& l) {l.sort();});
+		run(opt,"partial_sort_k10",values,[](clist& l) {l.partial_sort(10);});
+		run(opt,"partial_sort_k1000",values,[](clist& l) {l.partial_sort(1000);});
+		run(opt,"nth_element_median",values,[n](clist& l) {bench::keep(*l.nth_element(n / 2));});
+	}
+	return 0;
+}
@@ -0,0 +1,175 @@
+#include <circular_queue>
+#include <deque>
+#include <list>
+#include <vector>
+
+#include "bench.h"
+
+// circular_queue enqueue/dequeue at several capacities and payload sizes,
+// against std::list, std::deque and a plain power-of-two array ring. Each
+// container is driven through the same thin adapter: push, take front, pop.
+// list_backed is the queue as it was before the ring buffer: a circular_list
+// with a size check, one node allocated and freed per element.
+
+namespace
+{
+	const char* const suite = "circular_queue";
+
+	template <typename _Tp>
+	  struct circular_adapter
+	{
+		std::circular_queue<_Tp> q;
+
+		explicit circular_adapter(size_t cap) : q(cap) {}
+		bool push(const _Tp& v) {return q.enqueue(v);}
+		_Tp pop()
+		{
+			_Tp v = q.front();
+			q.dequeue();
+			return v;
+		}
+		size_t size() const {return q.size();}
+	};
+
+	template <typename _Tp,typename _Seq>
+	  struct sequence_adapter
+	{
+		_Seq q;
+		size_t cap;
+
+		explicit sequence_adapter(size_t c) : cap(c) {}
+		bool push(const _Tp& v)
+		{
+			if (q.size() == cap) return false;
+			q.push_back(v);
+			return true;
+		}
+		_Tp pop()
+		{
+			_Tp v = q.front();
+			q.pop_front();
+			return v;
+		}
+		size_t size() const {return q.size();}
+	};
+
+	template <typename _Tp>
+	  struct list_backed
+	{
+		std::circular_list<_Tp> q;
+		size_t cap;
+
+		explicit list_backed(size_t c) : cap(c) {}
+		bool push(const _Tp& v)
+		{
+			if (q.size() == cap) return false;
+			q.insert(q.end(),v);
+			return true;
+		}
+		_Tp pop()
+		{
+			_Tp v = q.front();
+			q.erase(q.begin());
+			return v;
+		}
+		size_t size() const {return q.size();}
+	};
+
+	// The hand-written baseline: one vector, masked indices, no bookkeeping
+	// beyond what a bounded ring needs.
+	template <typename _Tp>
+	  struct array_ring
+	{
+		std::vector<_Tp> slots;
+		size_t mask;
+		size_t head;
+		size_t count;
+		size_t cap;
+
+		explicit array_ring(size_t c) : mask(0),head(0),count(0),cap(c)
+		{
+			size_t n = 1;
+			while (n < c) n <<= 1;
+			slots.resize(n);
+			mask = n - 1;
+		}
+		bool push(const _Tp& v)
+		{
+			if (count == cap) return false;
+			slots[(head + count++) & mask] = v;
+			return true;
+		}
+		_Tp pop()
+		{
+			_Tp v = slots[head];
+			head = (head + 1) & mask;
+			count--;
+			return v;
+		}
+		size_t size() const {return count;}
+	};
+
+	// Steady state: half full, one push and one pop per operation.
+	template <typename _Queue,typename _Tp>
+	  void steady(const bench::options& opt,const char* name,const char* payload,size_t cap,size_t ops)
+	{
+		double ns = bench::best_ns(opt,[&]
+		{
+			_Queue q(cap);
+			for (size_t i = 0;i < cap / 2;i++) q.push(_Tp(i));
+			for (size_t i = 0;i < ops;i++)
+			{
+				q.push(_Tp(i));
+				bench::keep(q.pop());
+			}
+		});
+		bench::report(suite,"steady",name,payload,cap,ops,ns);
+	}
+
+	// Bursts: fill to capacity, then drain completely.
+	template <typename _Queue,typename _Tp>
+	  void burst(const bench::options& opt,const char* name,const char* payload,size_t cap,size_t ops)
+	{
+		size_t rounds = ops / cap ? ops / cap : 1;
+		double ns = bench::best_ns(opt,[&]
+		{
+			_Queue q(cap);
+			for (size_t r = 0;r < rounds;r++)
+			{
+				while (q.push(_Tp(r))) {}
+				while (q.size()) bench::keep(q.pop());
+			}
+		});
+		bench::report(suite,"burst",name,payload,cap,rounds * cap,ns);
+	}
+
+	template <typename _Tp>
+	  void run(const bench::options& opt,const char* payload,size_t cap,size_t ops)
+	{
+		steady<circular_adapter<_Tp>,_Tp>(opt,"circular_queue",payload,cap,ops);
+		steady<list_backed<_Tp>,_Tp>(opt,"list_backed",payload,cap,ops);
+		steady<sequence_adapter<_Tp,std::list<_Tp> >,_Tp>(opt,"std::list",payload,cap,ops);
+		steady<sequence_adapter<_Tp,std::deque<_Tp> >,_Tp>(opt,"std::deque",payload,cap,ops);
+		steady<array_ring<_Tp>,_Tp>(opt,"array_ring",payload,cap,ops);
+
+		burst<circular_adapter<_Tp>,_Tp>(opt,"circular_queue",payload,cap,ops);
+		burst<list_backed<_Tp>,_Tp>(opt,"list_backed",payload,cap,ops);
+		burst<sequence_adapter<_Tp,std::list<_Tp> >,_Tp>(opt,"std::list",payload,cap,ops);
+		burst<sequence_adapter<_Tp,std::deque<_Tp> >,_Tp>(opt,"std::deque",payload,cap,ops);
+		burst<array_ring<_Tp>,_Tp>(opt,"array_ring",payload,cap,ops);
+	}
+}
+
+int main(int argc,char** argv)
+{
+	bench::options opt = bench::parse(argc,argv);
+	size_t ops = opt.quick ? 10000 : 4000000;
+	const size_t capacities[] = {16,1024,65536};
+	for (size_t cap : capacities)
+	{
+		run<bench::payload<4> >(opt,"4B",cap,ops);
+		run<bench::payload<64> >(opt,"64B",cap,ops);
+		run<bench::payload<256> >(opt,"256B",cap,ops);
+	}
+	return 0;
+}
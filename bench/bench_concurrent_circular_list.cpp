@@ -0,0 +1,110 @@
+#include <concurrent_circular_list>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+
+// Reader scaling of concurrent_circular_list against circular_list behind a
+// std::shared_mutex: 1..N threads each walk a 64-member ring a fixed number
+// of times while one writer swaps a member out and back in every 100us.
+// The last run uses 160 readers, more than one block of reader slots, so the
+// slot registry has to grow while it runs.
+
+namespace
+{
+	const char* const suite = "concurrent_circular_list";
+	const int members = 64;
+
+	struct lock_free_ring
+	{
+		std::concurrent_circular_list<int> l;
+
+		lock_free_ring() {for (int i = 0;i < members;i++) l.push_back(i);}
+		long walk() const
+		{
+			long sum = 0;
+			l.for_each([&sum](int v) {sum += v;});
+			return sum;
+		}
+		void churn(int v)
+		{
+			l.remove(v);
+			l.push_back(v);
+		}
+	};
+
+	struct shared_mutex_ring
+	{
+		mutable std::shared_mutex lock;
+		std::circular_list<int> l;
+
+		shared_mutex_ring() {for (int i = 0;i < members;i++) l.push_back(i);}
+		long walk() const
+		{
+			std::shared_lock<std::shared_mutex> guard(lock);
+			long sum = 0;
+			std::circular_list<int>::const_iterator it = l.begin();
+			for (size_t i = 0;i < l.size();i++,++it) sum += *it;
+			return sum;
+		}
+		void churn(int v)
+		{
+			std::unique_lock<std::shared_mutex> guard(lock);
+			l.remove(v);
+			l.push_back(v);
+		}
+	};
+
+	template <typename _Ring>
+	  void readers(const bench::options& opt,const char* name,unsigned threads,size_t walks)
+	{
+		size_t per_thread = walks / threads ? walks / threads : 1;
+		double ns = bench::best_ns(opt,[&]
+		{
+			_Ring ring;
+			std::atomic<unsigned> finished(0);
+			std::thread writer([&ring,&finished,threads]
+			{
+				for (int v = 0;finished.load(std::memory_order_relaxed) < threads;v = (v + 1) % members)
+				{
+					ring.churn(v);
+					std::this_thread::sleep_for(std::chrono::microseconds(100));
+				}
+			});
+			std::vector<std::thread> pool;
+			for (unsigned t = 0;t < threads;t++)
+			{
+				pool.emplace_back([&ring,&finished,per_thread]
+				{
+					long sum = 0;
+					for (size_t i = 0;i < per_thread;i++) sum += ring.walk();
+					bench::keep(sum);
+					finished++;
+				});
+			}
+			for (std::thread& t : pool) t.join();
+			writer.join();
+		});
+		bench::report(suite,"reader_scaling",name,"4B",threads,per_thread * threads,ns);
+	}
+}
+
+int main(int argc,char** argv)
+{
+	bench::options opt = bench::parse(argc,argv);
+	size_t walks = opt.quick ? 4000 : 2000000;
+	unsigned max_threads = std::max(4u,std::thread::hardware_concurrency()) * 2;
+	std::vector<unsigned> counts;
+	for (unsigned n = 1;n <= max_threads;n *= 2) counts.push_back(n);
+	counts.push_back(opt.quick ? 16 : 160);
+	for (unsigned n : counts)
+	{
+		readers<lock_free_ring>(opt,"concurrent_circular_list",n,walks);
+		readers<shared_mutex_ring>(opt,"shared_mutex+circular_list",n,walks);
+	}
+	return 0;
+}
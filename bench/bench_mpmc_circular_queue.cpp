@@ -0,0 +1,91 @@
+#include <concurrent_circular_queue>
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+
+// Fan-in/fan-out scaling of mpmc_circular_queue from one producer/consumer
+// pair up to the hardware thread count, against circular_queue behind one
+// mutex. Each configuration moves the same total number of items.
+
+namespace
+{
+	const char* const suite = "mpmc_circular_queue";
+
+	struct locked_queue
+	{
+		std::mutex lock;
+		std::circular_queue<size_t> q;
+
+		explicit locked_queue(size_t cap) : q(cap) {}
+		void spin_enqueue(size_t v)
+		{
+			for (;;)
+			{
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					if (q.enqueue(v)) return;
+				}
+				std::this_thread::yield();
+			}
+		}
+		void spin_dequeue(size_t& out)
+		{
+			for (;;)
+			{
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					if (!q.isEmpty())
+					{
+						out = q.front();
+						q.dequeue();
+						return;
+					}
+				}
+				std::this_thread::yield();
+			}
+		}
+	};
+
+	template <typename _Queue>
+	  void scale(const bench::options& opt,const char* name,unsigned pairs,size_t total)
+	{
+		size_t per_thread = total / pairs;
+		double ns = bench::best_ns(opt,[&]
+		{
+			_Queue q(1024);
+			std::vector<std::thread> threads;
+			for (unsigned p = 0;p < pairs;p++)
+			{
+				threads.emplace_back([&q,per_thread]
+				{
+					for (size_t i = 0;i < per_thread;i++) q.spin_enqueue(i);
+				});
+				threads.emplace_back([&q,per_thread]
+				{
+					size_t v = 0;
+					for (size_t i = 0;i < per_thread;i++) q.spin_dequeue(v);
+					bench::keep(v);
+				});
+			}
+			for (std::thread& t : threads) t.join();
+		});
+		bench::report(suite,"producer_consumer_pairs",name,"8B",pairs,per_thread * pairs,ns);
+	}
+}
+
+int main(int argc,char** argv)
+{
+	bench::options opt = bench::parse(argc,argv);
+	size_t total = opt.quick ? 20000 : 8000000;
+	unsigned max_pairs = std::max(2u,std::thread::hardware_concurrency() / 2);
+	if (opt.quick) max_pairs = 2;
+	for (unsigned pairs = 1;pairs <= max_pairs;pairs *= 2)
+	{
+		scale<std::mpmc_circular_queue<size_t> >(opt,"mpmc_circular_queue",pairs,total);
+		scale<locked_queue>(opt,"mutex+circular_queue",pairs,total);
+	}
+	return 0;
+}
@@ -0,0 +1,111 @@
+#include <concurrent_circular_queue>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "bench.h"
+
+// spsc_circular_queue against a circular_queue behind a mutex, the pattern it
+// replaces. Throughput streams n items from one thread to another; latency
+// bounces one item back and forth through a pair of queues and reports the
+// round trip. Both sides spin with yield, so on a single core the numbers
+// mostly measure the scheduler.
+
+namespace
+{
+	const char* const suite = "spsc_circular_queue";
+
+	template <typename _Tp>
+	  struct locked_queue
+	{
+		std::mutex lock;
+		std::circular_queue<_Tp> q;
+
+		explicit locked_queue(size_t cap) : q(cap) {}
+		bool enqueue(const _Tp& v)
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			return q.enqueue(v);
+		}
+		bool dequeue(_Tp& out)
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			if (q.isEmpty()) return false;
+			out = q.front();
+			return q.dequeue();
+		}
+	};
+
+	template <typename _Queue>
+	  void throughput(const bench::options& opt,const char* name,size_t cap,size_t n)
+	{
+		double ns = bench::best_ns(opt,[&]
+		{
+			_Queue q(cap);
+			std::thread producer([&]
+			{
+				for (size_t i = 0;i < n;i++)
+				{
+					while (!q.enqueue(i)) std::this_thread::yield();
+				}
+			});
+			size_t sum = 0;
+			for (size_t got = 0;got < n;)
+			{
+				size_t v;
+				if (q.dequeue(v))
+				{
+					sum += v;
+					got++;
+				}
+				else std::this_thread::yield();
+			}
+			producer.join();
+			bench::keep(sum);
+		});
+		bench::report(suite,"throughput",name,"8B",cap,n,ns);
+	}
+
+	template <typename _Queue>
+	  void latency(const bench::options& opt,const char* name,size_t rounds)
+	{
+		double ns = bench::best_ns(opt,[&]
+		{
+			_Queue ping(1);
+			_Queue pong(1);
+			std::thread echo([&]
+			{
+				for (size_t i = 0;i < rounds;i++)
+				{
+					size_t v;
+					while (!ping.dequeue(v)) std::this_thread::yield();
+					while (!pong.enqueue(v)) std::this_thread::yield();
+				}
+			});
+			for (size_t i = 0;i < rounds;i++)
+			{
+				size_t v = i;
+				while (!ping.enqueue(v)) std::this_thread::yield();
+				while (!pong.dequeue(v)) std::this_thread::yield();
+			}
+			echo.join();
+		});
+		bench::report(suite,"round_trip",name,"8B",1,rounds,ns);
+	}
+}
+
+int main(int argc,char** argv)
+{
+	bench::options opt = bench::parse(argc,argv);
+	size_t n = opt.quick ? 20000 : 10000000;
+	size_t rounds = opt.quick ? 2000 : 200000;
+	const size_t capacities[] = {64,1024,65536};
+	for (size_t cap : capacities)
+	{
+		throughput<std::spsc_circular_queue<size_t> >(opt,"spsc_circular_queue",cap,n);
+		throughput<locked_queue<size_t> >(opt,"mutex+circular_queue",cap,n);
+	}
+	latency<std::spsc_circular_queue<size_t> >(opt,"spsc_circular_queue",rounds);
+	latency<locked_queue<size_t> >(opt,"mutex+circular_queue",rounds);
+	return 0;
+}
@@ -0,0 +1,139 @@
+#include <timing_wheel>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+
+// timing_wheel against a std::priority_queue timer set with lazy
+// cancellation (a per-timer generation; stale heap entries are skipped when
+// they surface), at 10^5 and 10^6 connection-style timeouts:
+//   arm_cancel  arm every timer, cancel 90% of them, run the clock out;
+//   rearm       timers are re-armed on activity far more often than they fire,
+//               with the clock ticking forward as it goes.
+
+namespace
+{
+	const char* const suite = "timing_wheel";
+	const uint64_t timeout = 30000;
+
+	struct connection : std::timing_wheel_timer
+	{
+		size_t fired;
+
+		connection() : fired(0) {}
+	};
+
+	struct wheel_set
+	{
+		// Declared first so the wheel is destroyed while its timers still exist.
+		std::vector<connection> timers;
+		std::timing_wheel wheel;
+
+		explicit wheel_set(size_t n) : timers(n) {}
+		void arm(size_t id,uint64_t expires) {wheel.schedule(timers[id],expires);}
+		void cancel(size_t id) {wheel.cancel(timers[id]);}
+		size_t advance(uint64_t now) {return wheel.advance(now,[](std::timing_wheel_timer& t) {static_cast<connection&>(t).fired++;});}
+	};
+
+	struct heap_set
+	{
+		struct entry
+		{
+			uint64_t expires;
+			size_t id;
+			uint32_t generation;
+
+			bool operator>(const entry& other) const {return expires > other.expires;}
+		};
+
+		std::priority_queue<entry,std::vector<entry>,std::greater<entry> > heap;
+		std::vector<uint32_t> generation;
+		std::vector<bool> armed;
+		std::vector<size_t> fired;
+
+		explicit heap_set(size_t n) : generation(n,0),armed(n,false),fired(n,0) {}
+		void arm(size_t id,uint64_t expires)
+		{
+			armed[id] = true;
+			heap.push(entry{expires,id,++generation[id]});
+		}
+		void cancel(size_t id)
+		{
+			armed[id] = false;
+			++generation[id];
+		}
+		size_t advance(uint64_t now)
+		{
+			size_t count = 0;
+			while (!heap.empty() && heap.top().expires <= now)
+			{
+				entry e = heap.top();
+				heap.pop();
+				if (!armed[e.id] || e.generation != generation[e.id]) continue;
+				armed[e.id] = false;
+				fired[e.id]++;
+				count++;
+			}
+			return count;
+		}
+	};
+
+	template <typename _Set>
+	  void arm_cancel(const bench::options& opt,const char* name,size_t n)
+	{
+		std::mt19937_64 gen(3);
+		std::vector<uint64_t> deadlines(n);
+		for (size_t i = 0;i < n;i++) deadlines[i] = 1 + gen() % timeout;
+		size_t fired = 0;
+		double ns = bench::best_ns(opt,[&]
+		{
+			_Set set(n);
+			for (size_t i = 0;i < n;i++) set.arm(i,deadlines[i]);
+			for (size_t i = 0;i < n;i++) if (i % 10) set.cancel(i);
+			for (uint64_t now = 0;now <= timeout;now += 16) fired = set.advance(now) + fired;
+		});
+		bench::keep(fired);
+		bench::report(suite,"arm_cancel",name,"timer",n,2 * n,ns);
+	}
+
+	template <typename _Set>
+	  void rearm(const bench::options& opt,const char* name,size_t n)
+	{
+		std::mt19937_64 gen(5);
+		size_t ops = n * 8;
+		std::vector<size_t> touched(ops);
+		for (size_t i = 0;i < ops;i++) touched[i] = static_cast<size_t>(gen() % n);
+		size_t fired = 0;
+		double ns = bench::best_ns(opt,[&]
+		{
+			_Set set(n);
+			uint64_t now = 0;
+			for (size_t i = 0;i < n;i++) set.arm(i,now + timeout);
+			for (size_t i = 0;i < ops;i++)
+			{
+				set.arm(touched[i],now + timeout);
+				if (i % 64 == 63) fired += set.advance(++now);
+			}
+		});
+		bench::keep(fired);
+		bench::report(suite,"rearm",name,"timer",n,ops,ns);
+	}
+}
+
+int main(int argc,char** argv)
+{
+	bench::options opt = bench::parse(argc,argv);
+	const size_t sizes[] = {100000,1000000};
+	for (size_t n : sizes)
+	{
+		if (opt.quick) n /= 100;
+		arm_cancel<wheel_set>(opt,"timing_wheel",n);
+		arm_cancel<heap_set>(opt,"std::priority_queue",n);
+		rearm<wheel_set>(opt,"timing_wheel",n);
+		rearm<heap_set>(opt,"std::priority_queue",n);
+	}
+	return 0;
+}
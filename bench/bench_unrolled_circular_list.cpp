@@ -0,0 +1,82 @@
+#include <circular_list>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+
+// unrolled_circular_list against the one-element-per-node circular_list for
+// int and double payloads: a full traversal, random operator[] and sort.
+
+namespace
+{
+	const char* const suite = "unrolled_circular_list";
+
+	// circular_list::iterator wraps past the sentinel, so walk by count.
+	template <typename _Tp>
+	  _Tp sum_all(std::circular_list<_Tp>& l)
+	{
+		_Tp sum = _Tp();
+		typename std::circular_list<_Tp>::iterator it = l.begin();
+		for (size_t i = 0;i < l.size();i++,++it) sum += *it;
+		return sum;
+	}
+
+	template <typename _Tp>
+	  _Tp sum_all(std::unrolled_circular_list<_Tp>& l)
+	{
+		_Tp sum = _Tp();
+		for (const _Tp& v : l) sum += v;
+		return sum;
+	}
+
+	template <typename _List,typename _Tp>
+	  void run(const bench::options& opt,const char* name,const char* payload,size_t n)
+	{
+		std::mt19937 gen(1);
+		std::vector<_Tp> values(n);
+		for (size_t i = 0;i < n;i++) values[i] = static_cast<_Tp>(gen() % 1000000);
+		_List l;
+		for (const _Tp& v : values) l.push_back(v);
+
+		size_t passes = 8;
+		double ns = bench::best_ns(opt,[&] {for (size_t p = 0;p < passes;p++) bench::keep(sum_all(l));});
+		bench::report(suite,"traverse",name,payload,n,passes * n,ns);
+
+		size_t lookups = n < 100000 ? 2000 : 200;
+		ns = bench::best_ns(opt,[&]
+		{
+			_Tp sum = _Tp();
+			for (size_t i = 0;i < lookups;i++) sum += l[static_cast<int>((i * 7919) % n)];
+			bench::keep(sum);
+		});
+		bench::report(suite,"operator_index",name,payload,n,lookups,ns);
+
+		ns = bench::best_ns(opt,[&] {l.clear();for (const _Tp& v : values) l.push_back(v);},[&] {l.sort();});
+		bench::report(suite,"sort",name,payload,n,n,ns);
+	}
+
+	template <typename _Tp>
+	  void both(const bench::options& opt,const char* payload,size_t n)
+	{
+		run<std::circular_list<_Tp>,_Tp>(opt,"circular_list",payload,n);
+		run<std::unrolled_circular_list<_Tp>,_Tp>(opt,"unrolled_circular_list",payload,n);
+	}
+}
+
+int main(int argc,char** argv)
+{
+	bench::options opt = bench::parse(argc,argv);
+	std::vector<size_t> sizes;
+	sizes.push_back(1000);
+	if (!opt.quick)
+	{
+		sizes.push_back(100000);
+		sizes.push_back(1000000);
+	}
+	for (size_t n : sizes)
+	{
+		both<int>(opt,"int",n);
+		both<double>(opt,"double",n);
+	}
+	return 0;
+}
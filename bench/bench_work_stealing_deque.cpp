@@ -0,0 +1,112 @@
+#include <concurrent_circular_queue>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+
+// A fork-join style workload: one owner pushes tasks in bursts and works
+// through them from the bottom while 1..N thieves steal from the top, on
+// work_stealing_deque against the std::deque behind a mutex it replaces.
+// Every task is a few hundred cycles of busy work so stealing pays off.
+
+namespace
+{
+	const char* const suite = "work_stealing_deque";
+
+	struct locked_deque
+	{
+		std::mutex lock;
+		std::deque<size_t> q;
+
+		explicit locked_deque(size_t) {}
+		void push(size_t v)
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			q.push_back(v);
+		}
+		bool pop(size_t& out)
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			if (q.empty()) return false;
+			out = q.back();
+			q.pop_back();
+			return true;
+		}
+		bool try_steal(size_t& out)
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			if (q.empty()) return false;
+			out = q.front();
+			q.pop_front();
+			return true;
+		}
+		bool isEmpty()
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			return q.empty();
+		}
+	};
+
+	size_t work(size_t v)
+	{
+		for (int i = 0;i < 64;i++) v = v * 6364136223846793005ULL + 1442695040888963407ULL;
+		return v;
+	}
+
+	template <typename _Deque>
+	  void owner_and_thieves(const bench::options& opt,const char* name,unsigned thieves,size_t tasks)
+	{
+		double ns = bench::best_ns(opt,[&]
+		{
+			_Deque d(64);
+			std::atomic<bool> done(false);
+			std::vector<std::thread> threads;
+			for (unsigned i = 0;i < thieves;i++)
+			{
+				threads.emplace_back([&d,&done]
+				{
+					size_t acc = 0;
+					for (;;)
+					{
+						size_t v;
+						if (d.try_steal(v)) acc += work(v);
+						else if (done.load(std::memory_order_acquire) && d.isEmpty()) break;
+						else std::this_thread::yield();
+					}
+					bench::keep(acc);
+				});
+			}
+			size_t acc = 0;
+			for (size_t next = 0;next < tasks;)
+			{
+				for (size_t i = 0;i < 256 && next < tasks;i++) d.push(next++);
+				size_t v;
+				for (size_t i = 0;i < 128 && d.pop(v);i++) acc += work(v);
+			}
+			size_t v;
+			while (d.pop(v)) acc += work(v);
+			done.store(true,std::memory_order_release);
+			for (std::thread& t : threads) t.join();
+			bench::keep(acc);
+		});
+		bench::report(suite,"owner_and_thieves",name,"8B",thieves,tasks,ns);
+	}
+}
+
+int main(int argc,char** argv)
+{
+	bench::options opt = bench::parse(argc,argv);
+	size_t tasks = opt.quick ? 20000 : 4000000;
+	unsigned max_thieves = std::max(2u,std::thread::hardware_concurrency());
+	if (opt.quick) max_thieves = 2;
+	for (unsigned n = 1;n <= max_thieves;n *= 2)
+	{
+		owner_and_thieves<std::work_stealing_deque<size_t> >(opt,"work_stealing_deque",n,tasks);
+		owner_and_thieves<locked_deque>(opt,"mutex+std::deque",n,tasks);
+	}
+	return 0;
+}
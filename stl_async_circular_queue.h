@@ -0,0 +1,315 @@
+#ifndef _STL_ASYNC_CIRCULAR_QUEUE_H_
+#define _STL_ASYNC_CIRCULAR_QUEUE_H_ 1
+
+#include <circular_queue>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+
+namespace std
+{
+	// Fire-and-forget coroutine for circular_executor::spawn; it starts
+	// suspended and frees its frame when it finishes.
+	struct circular_detached_task
+	{
+		struct promise_type
+		{
+			circular_detached_task get_return_object() noexcept {return circular_detached_task{std::coroutine_handle<promise_type>::from_promise(*this)};}
+			std::suspend_always initial_suspend() noexcept {return {};}
+			std::suspend_never final_suspend() noexcept {return {};}
+			void return_void() noexcept {}
+			void unhandled_exception() noexcept {std::terminate();}
+		};
+
+		std::coroutine_handle<promise_type> handle;
+	};
+
+	// Run queue of ready coroutines kept in a circular_queue that doubles when
+	// full. Drive it from one thread with run_until_idle(), or from a pool of
+	// threads that each call run() until stop().
+	class circular_executor
+	{
+		private:
+			std::mutex lock;
+			std::condition_variable ready;
+			circular_queue<std::coroutine_handle<> > handles;
+			bool stopping;
+
+			bool take(std::coroutine_handle<>& h,bool wait)
+			{
+				std::unique_lock<std::mutex> guard(lock);
+				if (wait) ready.wait(guard,[this] {return !handles.isEmpty() || stopping;});
+				if (handles.isEmpty()) return false;
+				h = *handles.begin();
+				handles.dequeue();
+				return true;
+			}
+
+		public:
+			explicit circular_executor(size_t cap = 64) : handles(cap),stopping(false) {}
+
+			circular_executor(const circular_executor&) = delete;
+			circular_executor& operator=(const circular_executor&) = delete;
+
+			// Coroutines still queued never ran past a suspension point here;
+			// their frames are destroyed rather than leaked.
+			~circular_executor()
+			{
+				std::coroutine_handle<> h;
+				while (take(h,false)) h.destroy();
+			}
+
+			void post(std::coroutine_handle<> h)
+			{
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					if (handles.is_full()) handles.setcapacity(handles.getcapacity() * 2);
+					handles.enqueue(h);
+				}
+				ready.notify_one();
+			}
+
+			void spawn(circular_detached_task task) {post(task.handle);}
+
+			bool run_one()
+			{
+				std::coroutine_handle<> h;
+				if (!take(h,false)) return false;
+				h.resume();
+				return true;
+			}
+
+			size_t run_until_idle()
+			{
+				size_t count = 0;
+				while (run_one()) count++;
+				return count;
+			}
+
+			// Resumes coroutines until stop() is called and the run queue is empty.
+			void run()
+			{
+				std::coroutine_handle<> h;
+				while (take(h,true)) h.resume();
+			}
+
+			void stop()
+			{
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					stopping = true;
+				}
+				ready.notify_all();
+			}
+	};
+
+	// circular_queue for coroutines: co_await pop() suspends while the queue is
+	// empty and co_await push(x) while it is full. Each awaiter lives in the
+	// awaiting coroutine's frame and links itself into a FIFO wait list, so a
+	// suspension allocates nothing. A push with a waiting popper hands the value
+	// straight to it; a pop from a full queue refills the freed slot from the
+	// first waiting pusher. Woken coroutines are resumed through the executor,
+	// never inline, and only after the queue lock is released.
+	template <typename _Tp,typename _Executor = circular_executor>
+	  class async_circular_queue
+	{
+		public:
+			typedef size_t size_type;
+			typedef _Tp* pointer;
+			typedef _Tp& reference;
+			typedef _Tp value_type;
+
+			class pop_awaiter
+			{
+				private:
+					friend class async_circular_queue;
+
+					async_circular_queue* queue;
+					pop_awaiter* next;
+					std::coroutine_handle<> waiter;
+					std::optional<_Tp> value;
+
+				public:
+					explicit pop_awaiter(async_circular_queue* q) noexcept : queue(q),next(nullptr) {}
+
+					bool await_ready() const noexcept {return false;}
+					bool await_suspend(std::coroutine_handle<> h) {return queue->suspend_pop(*this,h);}
+					_Tp await_resume() {return std::move(*value);}
+			};
+
+			class push_awaiter
+			{
+				private:
+					friend class async_circular_queue;
+
+					async_circular_queue* queue;
+					push_awaiter* next;
+					std::coroutine_handle<> waiter;
+					_Tp value;
+
+				public:
+					push_awaiter(async_circular_queue* q,_Tp&& v) : queue(q),next(nullptr),value(std::move(v)) {}
+
+					bool await_ready() const noexcept {return false;}
+					bool await_suspend(std::coroutine_handle<> h) {return queue->suspend_push(*this,h);}
+					void await_resume() const noexcept {}
+			};
+
+		private:
+			template <typename _Awaiter>
+			  struct wait_list
+			{
+				_Awaiter* first;
+				_Awaiter* last;
+
+				wait_list() noexcept : first(nullptr),last(nullptr) {}
+
+				bool empty() const noexcept {return first == nullptr;}
+
+				void push(_Awaiter* a) noexcept
+				{
+					a->next = nullptr;
+					if (last) last->next = a;
+					else first = a;
+					last = a;
+				}
+
+				_Awaiter* pop() noexcept
+				{
+					_Awaiter* a = first;
+					first = a->next;
+					if (!first) last = nullptr;
+					return a;
+				}
+			};
+
+			std::mutex lock;
+			circular_queue<_Tp> ring;
+			wait_list<pop_awaiter> poppers;
+			wait_list<push_awaiter> pushers;
+			_Executor& executor;
+
+			// Called with the lock held and the ring non-empty.
+			std::coroutine_handle<> take_front(std::optional<_Tp>& out)
+			{
+				out.emplace(std::move(*ring.begin()));
+				ring.dequeue();
+				if (pushers.empty()) return nullptr;
+				push_awaiter* p = pushers.pop();
+				ring.enqueue(std::move(p->value));
+				return p->waiter;
+			}
+
+			// Called with the lock held; returns false if the ring is full.
+			template <typename _Up>
+			  bool give(_Up&& value,std::coroutine_handle<>& wake)
+			{
+				if (!poppers.empty())
+				{
+					pop_awaiter* w = poppers.pop();
+					w->value.emplace(std::forward<_Up>(value));
+					wake = w->waiter;
+					return true;
+				}
+				return ring.enqueue(std::forward<_Up>(value));
+			}
+
+			void resume_later(std::coroutine_handle<> h)
+			{
+				if (h) executor.post(h);
+			}
+
+			bool suspend_pop(pop_awaiter& a,std::coroutine_handle<> h)
+			{
+				std::coroutine_handle<> wake;
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					if (ring.isEmpty())
+					{
+						a.waiter = h;
+						poppers.push(&a);
+						return true;
+					}
+					wake = take_front(a.value);
+				}
+				resume_later(wake);
+				return false;
+			}
+
+			bool suspend_push(push_awaiter& a,std::coroutine_handle<> h)
+			{
+				std::coroutine_handle<> wake;
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					if (!give(std::move(a.value),wake))
+					{
+						a.waiter = h;
+						pushers.push(&a);
+						return true;
+					}
+				}
+				resume_later(wake);
+				return false;
+			}
+
+		public:
+			async_circular_queue(size_type cap,_Executor& ex) : ring(cap),executor(ex) {}
+
+			async_circular_queue(const async_circular_queue&) = delete;
+			async_circular_queue& operator=(const async_circular_queue&) = delete;
+
+			pop_awaiter pop() noexcept {return pop_awaiter(this);}
+			push_awaiter push(const value_type& value) {return push_awaiter(this,_Tp(value));}
+			push_awaiter push(value_type&& value) {return push_awaiter(this,std::move(value));}
+
+			// Non-suspending forms for callers outside a coroutine.
+			bool try_push(const value_type& value)
+			{
+				std::coroutine_handle<> wake;
+				bool ok;
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					ok = give(value,wake);
+				}
+				resume_later(wake);
+				return ok;
+			}
+
+			bool try_pop(value_type& out)
+			{
+				std::optional<_Tp> value;
+				std::coroutine_handle<> wake;
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					if (ring.isEmpty()) return false;
+					wake = take_front(value);
+				}
+				out = std::move(*value);
+				resume_later(wake);
+				return true;
+			}
+
+			bool isEmpty()
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				return ring.isEmpty();
+			}
+
+			bool is_full()
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				return ring.is_full();
+			}
+
+			size_type size()
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				return ring.size();
+			}
+
+			size_type getcapacity() const {return ring.getcapacity();}
+	};
+}
+#endif
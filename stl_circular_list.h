@@ -1,669 +1,1327 @@
-#ifndef _STL_CIRCULAR_LIST_H_
-#define _STL_CIRCULAR_LIST_H_ 1
-
-#include <cstddef>
-#include <stdexcept>
-#include <iterator>
-#include <algorithm> 
-#include <limits>
-#if __cplusplus >= 201103L
-#include <initializer_list>
-#include <vector>
-#include <list>
-#include <utility>
-#include <queue>
-#include <forward_list>
-#include <stack>
-#include <deque>
-#if __has_include(<circular_queue>)
-#include <circular_queue>
-#endif
-#endif
-
-namespace std _GLIBCXX_VISIBILITY(default)
-{
-_GLIBCXX_BEGIN_NAMESPACE_CONTAINER
-    template<typename _Tp>
-      class circular_list
-    {
-        public:
-            struct node
-            {
-                node* next;
-                node* prev;
-                _Tp value;
-                
-                template <typename... Args>
-                  node(node* n = nullptr,node* p = nullptr,Args&&... args) : next(n),prev(p),value(std::forward<Args>(args)...) {}
-            };
-            
-            class iterator
-            {
-	            public:
-	                typedef std::bidirectional_iterator_tag iterator_category;
-	                typedef _Tp value_type;
-	                typedef ptrdiff_t difference_type;
-	                typedef _Tp* pointer;
-	                typedef _Tp& reference;
-	                
-	                iterator() : _node(nullptr),_head(nullptr) {}
-	                iterator(node* n,node* h) : _node(n),_head(h) {}
-	                reference operator*() const {return _node->value;}
-	                pointer operator->() const {return &_node->value;}
-	                
-	                iterator& operator++()
-					{
-	                    _node = _node->next;
-	                    if (_node == _head) _node = _head->next;
-                   		return *this;
-	                }
-	                
-	                iterator operator++(int)
-					{
-	                    iterator tmp = *this;
-	                    ++(*this);
-	                    return tmp;
-	                }
-	                
-	                iterator& operator--()
-					{
-	                    _node = (_node->prev != _head) ? _node->prev : _head->prev;
-	                    return *this;
-	                }
-	                
-	                iterator operator--(int)
-					{
-	                    iterator tmp = *this;
-	                    --(*this);
-	                    return tmp;
-	                }
-	                
-	                bool operator==(const iterator& other) const {return _node == other._node;}
-	                bool operator!=(const iterator& other) const {return _node != other._node;}
-	                node* get_node() const {return _node;}
-	                
-	            private:
-	                node* _node;
-	                node* _head;
-	                friend class circular_list;
-            };
-            
-            class const_iterator
-            {
-            public:
-                typedef std::bidirectional_iterator_tag iterator_category;
-                typedef const _Tp value_type;
-                typedef ptrdiff_t difference_type;
-                typedef const _Tp* pointer;
-                typedef const _Tp& reference;
-                
-                const_iterator() : _node(nullptr),_head(nullptr) {}
-                const_iterator(const node* n,const node* h) : _node(n),_head(h) {}
-                const_iterator(const iterator& it) : _node(it.get_node()),_head(it.get_head()) {}
-                
-                reference operator*() const {return _node->value;}
-                pointer operator->() const {return &_node->value;}
-                
-                const_iterator& operator++()
-				{
-                    _node = _node->next;
-	                if (_node == _head) _node = _head->next;
-                   	return *this;
-                }
-                
-                const_iterator operator++(int)
-				{
-                    const_iterator tmp = *this;
-                    ++(*this);
-                    return tmp;
-                }
-                
-                const_iterator& operator--()
-				{
-                    _node = (_node->prev != _head) ? _node->prev : _head->prev;
-                    return *this;
-                }
-                
-                const_iterator operator--(int)
-				{
-                    const_iterator tmp = *this;
-                    --(*this);
-                    return tmp;
-                }
-                
-                bool operator==(const const_iterator& other) const {return _node == other._node;}
-                bool operator!=(const const_iterator& other) const {return _node != other._node;}
-                const node* get_node() const {return _node;}
-                
-            private:
-                const node* _node;
-                const node* _head;
-                friend class circular_list;
-            };
-            
-            typedef size_t size_type;
-            typedef _Tp value_type;
-        
-        private:
-            node* head;
-            size_type length;
-        
-        public:
-            circular_list() : length(0)
-            {
-                head = new node(head,head);
-                head->next = head;
-                head->prev = head;
-            }
-        
-            circular_list(const circular_list& other) : circular_list() {for (auto iter = other.begin();iter != other.end();++iter) push_back(*iter);}
-        
-#if __cplusplus >= 201103L
-            circular_list(circular_list&& other) noexcept : head(other.head),length(other.length)
-            {
-                other.head = new node(other.head,other.head);
-                other.head->next = other.head;
-                other.head->prev = other.head;
-                other.length = 0;
-            }
-            
-            circular_list(std::initializer_list<value_type> init) : circular_list() {for (auto val : init) push_back(val);}
-#endif
-        
-            ~circular_list()
-            {
-                clear();
-                delete head;
-            }
-        
-            circular_list& operator=(const circular_list& other)
-            {
-                if (this != &other)
-                {
-                    clear();
-                    for (auto iter = other.begin();iter != other.end();++iter) push_back(*iter);
-                }
-                return *this;
-            }
-        
-#if __cplusplus >= 201103L
-            circular_list& operator=(circular_list&& other) noexcept
-            {
-                if (this != &other)
-                {
-                    clear();
-                    delete head;
-                    head = other.head;
-                    length = other.length;
-                    other.head = new node(other.head, other.head);
-                    other.head->next = other.head;
-                    other.head->prev = other.head;
-                    other.length = 0;
-                }
-                return *this;
-            }
-        
-            circular_list& operator=(std::initializer_list<value_type> init_list)
-            {
-                assign(init_list);
-                return *this;
-            }
-#endif
-        
-            [[nodiscard]] bool empty() const {return head->next == head;}
-            [[nodiscard]] size_type size() const {return length;}
-        
-            value_type& front()
-            {
-                if (empty()) throw std::out_of_range("List Is Empty!");
-                return head->next->value;
-            }
-            
-            const value_type& front() const
-            {
-                if (empty()) throw std::out_of_range("List Is Empty!");
-                return head->next->value;
-            }
-            
-            value_type& back()
-            {
-                if (empty()) throw std::out_of_range("List Is Empty!");
-                return head->prev->value;
-            }
-            
-            const value_type& back() const
-            {
-                if (empty()) throw std::out_of_range("List Is Empty!");
-                return head->prev->value;
-            }
-        
-            void clear()
-            {
-                node* curr = head->next;
-                while (curr != head)
-                {
-                    node* temp = curr;
-                    curr = curr->next;
-                    delete temp;
-                }
-                head->next = head;
-                head->prev = head;
-                length = 0;
-            }
-            
-            void insert(iterator pos,const value_type& val)
-            {
-                node* p = pos.get_node();
-                if (!p || p == head) p = head;
-                node* newNode = new node(p,p->prev,val);
-                p->prev->next = newNode;
-                p->prev = newNode;
-                length++;
-            }
-            
-#if __cplusplus >= 201103L
-            void insert(iterator pos,value_type&& val)
-            {
-                node* p = pos.get_node();
-                if (!p || p == head) p = head;
-                node* newNode = new node(p, p->prev,std::move(val));
-                p->prev->next = newNode;
-                p->prev = newNode;
-                length++;
-            }
-#endif
-            void erase(iterator pos)
-            {
-                node* p = pos.get_node();
-                if (!p || p == head) return;
-                p->prev->next = p->next;
-                p->next->prev = p->prev;
-                delete p;
-                length--;
-            }
-            
-            void erase(iterator start,iterator end)
-            {
-                iterator curr = start;
-                while (curr != end)
-                {
-                    iterator next = curr;
-                    ++next;
-                    erase(curr);
-                    curr = next;
-                }
-            }
-            
-            void push_back(const value_type& val) {insert(end(),val);}
-            void push_front(const value_type& val) {insert(begin(),val);}
-#if __cplusplus >= 201103L
-            void push_back(value_type&& val) {insert(end(),std::move(val));}
-            void push_front(value_type&& val) {insert(begin(),std::move(val));}
-#endif
-            
-            void pop_back()
-            {
-                if (empty()) throw std::out_of_range("List Is Empty!");
-                erase(iterator(head->prev, head));
-            }
-            
-            void pop_front()
-            {
-                if (empty()) throw std::out_of_range("List Is Empty!");
-                erase(iterator(head->next, head));
-            }
-        
-            iterator begin() noexcept {return iterator(head->next,head);}
-            iterator end() noexcept {return iterator(head,head);}
-            const_iterator begin() const noexcept {return const_iterator(head->next,head);}
-            const_iterator end() const noexcept {return const_iterator(head, head);}
-            const_iterator cbegin() const noexcept {return begin();}
-            const_iterator cend() const noexcept {return end();}
-            iterator start() noexcept {return begin();}
-            iterator last() noexcept {return iterator(head->prev,head);}
-        
-            void assign(size_type count,const value_type& value)
-            {
-                clear();
-                for (size_type i = 0; i < count; i++) push_back(value);
-            }
-        
-            template <typename Iter>
-              void assign(Iter first,Iter last)
-            {
-                clear();
-                for (;first != last;++first) push_back(*first);
-            }
-            
-            void assign(std::initializer_list<value_type> ilist)
-            {
-                clear();
-                for (auto val : ilist) push_back(val);
-            }
-
-            void resize(size_type new_size)
-            {
-                if (new_size == length) return;
-                if (new_size == 0) clear();
-                else if (new_size < length)
-                {
-                    auto iter = begin();
-                    for (size_type i = 0; i < new_size; i++) ++iter;
-                    erase(iter, end());
-                }
-                else for (size_type i = length;i < new_size;i++) push_back(value_type{});
-            }
-            
-#if __cplusplus >= 201103L
-            std::vector<value_type> to_vector() const
-            {
-                std::vector<value_type> vec;
-                for (auto iter = begin();iter != end();++iter) vec.push_back(*iter);
-                return vec;
-            }
-            
-            template <typename... Args>
-              iterator emplace(iterator pos,Args&&... args)
-            {
-                node* p = pos.get_node();
-                if (!p || p == head) p = head;
-                node* newNode = new node(p,p->prev,std::forward<Args>(args)...);
-                p->prev->next = newNode;
-                p->prev = newNode;
-                length++;
-                return iterator(newNode,head);
-            }
-            
-            template <typename... Args>
-              void emplace_front(Args&&... args) {emplace(begin(), std::forward<Args>(args)...);}
-            
-            template <typename... Args>
-              void emplace_back(Args&&... args) {emplace(end(), std::forward<Args>(args)...);}
-#endif
-            void sort() {sort([](const value_type& a,const value_type& b) {return a < b;});}
-            
-            template <typename Comp>
-              void sort(Comp c)
-            {
-                if (length < 2) return;
-                head->prev->next = nullptr;
-                head->next->prev = nullptr;
-                node* start = head->next;
-                head->next = iterative_merge_sort(start,c);
-                to_round();
-            }
-            
-            void reverse()
-            {
-                if (length < 2) return;
-                node* first = head->next;
-                node* last = head->prev;
-                first->prev = nullptr;
-                last->next = nullptr;
-                node* curr = first;
-                node* prev = nullptr;
-                node* next = nullptr;
-                while (curr)
-                {
-                    next = curr->next;
-                    curr->next = prev;
-                    curr->prev = next;
-                    prev = curr;
-                    curr = next;
-                }
-                head->next = last;
-                head->prev = first;
-                last->prev = head;
-                first->next = head;
-            }
-            
-            template<typename Compare>
-              void remove_if(Compare c)
-            {
-                iterator curr = begin();
-                while (curr != end())
-                {
-                    iterator next_node = curr;
-                    ++next_node;
-                    if (c(*curr)) erase(curr);
-                    curr = next_node;
-                }
-            }
-
-            void remove(const value_type& remove_val) {remove_if([&](const value_type& a) {return a == remove_val;});}
-            
-            void splice(iterator iter,circular_list& other)
-            {
-                node* p = iter.get_node();
-                if (!p) return;
-                iterator curr = other.begin();
-                while (curr != other.end())
-                {
-                    iterator next = curr;
-                    ++next;
-                    node* other_node = curr.get_node();
-                    other_node->prev->next = other_node->next;
-                    other_node->next->prev = other_node->prev;
-                    other.length--;
-                    other_node->prev = p->prev;
-                    other_node->next = p;
-                    p->prev->next = other_node;
-                    p->prev = other_node;
-                    length++;
-                    curr = next;
-                }
-            }
-            
-            void merge(circular_list& other) {splice(end(),other);}
-            
-            iterator find(const value_type& val)
-            {
-                iterator curr = begin();
-                while (curr != end())
-                {
-                    if (*curr == val) return curr;
-                    ++curr;
-                }
-                return end();
-            }
-            
-            iterator find(iterator start_iter,iterator end_iter,const value_type& val)
-            {
-                iterator curr = start_iter;
-                while (curr != end_iter)
-                {
-                    if (*curr == val) return curr;
-                    ++curr;
-                }
-                return end();
-            }
-            
-            void swap(iterator a, iterator b) noexcept
-            {
-                node* na = a.get_node();
-                node* nb = b.get_node();
-                if (!na || !nb || na == head || nb == head || na == nb) return;
-                std::swap(na->value, nb->value);
-            }
-            
-            circular_list split(iterator start_iter,iterator end_iter) const
-            {
-                circular_list split_list;
-                if (start_iter == end_iter) return split_list;
-                iterator curr = start_iter;
-                while (curr != end_iter && curr != end())
-                {
-                    split_list.push_back(*curr);
-                    ++curr;
-                }
-                return split_list;
-            }
-            
-            void unique()
-            {
-                if (length < 2) return;
-                iterator curr = begin();
-                ++curr;
-                while (curr != end())
-                {
-                    iterator next = curr;
-                    ++next;
-                    iterator prev = curr;
-                    --prev;
-                    if (*curr == *prev) erase(curr);
-                    curr = next;
-                }
-            }
-            
-            size_type max_size() const noexcept {return std::numeric_limits<size_type>::max() / sizeof(node);}
-            
-            value_type& operator[](int pos)
-            {
-                if (pos < 0 || static_cast<size_type>(pos) >= size()) throw std::out_of_range("Position out of range");
-                iterator curr = begin();
-                for (int i = 0;i < pos;i++) ++curr;
-                return *curr;
-            }
-            
-#if __cplusplus >= 201103L
-            std::list<value_type> to_list() const
-            {
-                std::list<value_type> lst;
-                for (auto iter = begin();iter != end();++iter) lst.push_back(*iter);
-                return lst;
-            }
-            
-            std::queue<value_type> to_queue() const
-            {
-                std::queue<value_type> que;
-                for (auto iter = begin();iter != end();++iter) que.push(*iter);
-                return que;
-            }
-            
-            std::forward_list<value_type> to_forward_list() const
-            {
-                std::forward_list<value_type> fwd_lst;
-                auto before_end = fwd_lst.before_begin();
-                for (auto iter = begin();iter != end();++iter) before_end = fwd_lst.insert_after(before_end, *iter);
-                return fwd_lst;
-            }
-            
-            std::stack<value_type> to_stack() const
-            {
-                std::stack<value_type> stk;
-                for (auto iter = begin();iter != end();++iter) stk.push(*iter);
-                return stk;
-            }
-
-            std::deque<value_type> to_deque() const
-            {
-                std::deque<value_type> deq;
-                for (auto iter = begin();iter != end();++iter) deq.push_back(*iter);
-                return deq;
-            }
-#endif
-        private:
-            template <typename Compare>
-              node* iterative_merge_sort(node* head_node,Compare c)
-            {
-                if (!head_node || !head_node->next) return head_node;
-                size_t size = 0;
-                node* temp = head_node;
-                while (temp)
-                {
-                    size++;
-                    temp = temp->next;
-                }
-                node dummy;
-                node* tail = &dummy;
-                dummy.next = nullptr;
-                for (size_t block_size = 1;block_size < size;block_size <<= 1)
-                {
-                    tail = &dummy;
-                    dummy.next = nullptr;
-                    node* left = head_node;
-                    node* right = head_node;
-                    while (left)
-                    {
-                        right = advance_block(left,block_size);
-                        node* next = advance_block(right,block_size);
-                        tail = merge_sublists(left,right,tail,c);
-                        left = next;
-                    }
-                    head_node = dummy.next;
-                }
-                return head_node;
-            }
-            
-            node* advance_block(node* start,size_t steps)
-            {
-                node* prev = nullptr;
-                for (size_t i = 0;i < steps && start;i++)
-                {
-                    prev = start;
-                    start = start->next;
-                }
-                if (prev) prev->next = nullptr;
-                return start;
-            }
-            
-            template <typename Compare>
-              node* merge_sublists(node* left,node* right,node* tail,Compare c)
-            {
-                while (left && right)
-                {
-                    if (c(left->value,right->value))
-                    {
-                        tail->next = left;
-                        left->prev = tail;
-                        tail = left;
-                        left = left->next;
-                    }
-                    else
-                    {
-                        tail->next = right;
-                        right->prev = tail;
-                        tail = right;
-                        right = right->next;
-                    }
-                }
-                if (left)
-                {
-                    tail->next = left;
-                    left->prev = tail;
-                    while (tail->next) tail = tail->next;
-                } 
-                else if (right)
-                {
-                    tail->next = right;
-                    right->prev = tail;
-                    while (tail->next) tail = tail->next;
-                }
-                
-                return tail;
-            }
-            
-            void to_round()
-            {
-                if (!head->next) 
-                {
-                    head->next = head;
-                    head->prev = head;
-                    return;
-                }
-                node* curr = head->next;
-                node* prev = head;
-                while (curr && curr != head)
-                {
-                    curr->prev = prev;
-                    prev = curr;
-                    curr = curr->next;
-                }
-                head->next->prev = head;
-                head->prev = prev;
-                prev->next = head;
-            }
-    };
-_GLIBCXX_END_NAMESPACE_CONTAINER
-}
-#endif
+#ifndef _STL_CIRCULAR_LIST_H_
+#define _STL_CIRCULAR_LIST_H_ 1
+
+#include <cstddef>
+#include <stdexcept>
+#include <iterator>
+#include <algorithm> 
+#include <limits>
+#include <memory>
+// The parallel path of sort() needs <thread> and <future>. Targets without
+// thread support, or builds that define _CIRCULAR_LIST_PARALLEL_SORT to 0,
+// keep the single-threaded natural merge sort and include neither header.
+#ifndef _CIRCULAR_LIST_PARALLEL_SORT
+#if (!defined(__GLIBCXX__) || defined(_GLIBCXX_HAS_GTHREADS)) && __has_include(<future>)
+#define _CIRCULAR_LIST_PARALLEL_SORT 1
+#else
+#define _CIRCULAR_LIST_PARALLEL_SORT 0
+#endif
+#endif
+#if _CIRCULAR_LIST_PARALLEL_SORT
+#include <thread>
+#include <future>
+#endif
+#if __cplusplus >= 201103L
+#include <initializer_list>
+#include <vector>
+#include <list>
+#include <utility>
+#include <queue>
+#include <forward_list>
+#include <stack>
+#include <deque>
+#endif
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_CONTAINER
+    template<typename _Tp,typename _Alloc = std::allocator<_Tp> >
+      class circular_list
+    {
+        public:
+            struct node
+            {
+                node* next;
+                node* prev;
+                _Tp value;
+                
+                template <typename... Args>
+                  node(node* n = nullptr,node* p = nullptr,Args&&... args) : next(n),prev(p),value(std::forward<Args>(args)...) {}
+            };
+            
+            class iterator
+            {
+	            public:
+	                typedef std::bidirectional_iterator_tag iterator_category;
+	                typedef _Tp value_type;
+	                typedef ptrdiff_t difference_type;
+	                typedef _Tp* pointer;
+	                typedef _Tp& reference;
+	                
+	                iterator() : _node(nullptr),_head(nullptr) {}
+	                iterator(node* n,node* h) : _node(n),_head(h) {}
+	                reference operator*() const {return _node->value;}
+	                pointer operator->() const {return &_node->value;}
+	                
+	                iterator& operator++()
+					{
+	                    _node = _node->next;
+	                    if (_node == _head) _node = _head->next;
+                   		return *this;
+	                }
+	                
+	                iterator operator++(int)
+					{
+	                    iterator tmp = *this;
+	                    ++(*this);
+	                    return tmp;
+	                }
+	                
+	                iterator& operator--()
+					{
+	                    _node = (_node->prev != _head) ? _node->prev : _head->prev;
+	                    return *this;
+	                }
+	                
+	                iterator operator--(int)
+					{
+	                    iterator tmp = *this;
+	                    --(*this);
+	                    return tmp;
+	                }
+	                
+	                bool operator==(const iterator& other) const {return _node == other._node;}
+	                bool operator!=(const iterator& other) const {return _node != other._node;}
+	                node* get_node() const {return _node;}
+	                
+	            private:
+	                node* _node;
+	                node* _head;
+	                friend class circular_list;
+            };
+            
+            class const_iterator
+            {
+            public:
+                typedef std::bidirectional_iterator_tag iterator_category;
+                typedef const _Tp value_type;
+                typedef ptrdiff_t difference_type;
+                typedef const _Tp* pointer;
+                typedef const _Tp& reference;
+                
+                const_iterator() : _node(nullptr),_head(nullptr) {}
+                const_iterator(const node* n,const node* h) : _node(n),_head(h) {}
+                const_iterator(const iterator& it) : _node(it.get_node()),_head(it.get_head()) {}
+                
+                reference operator*() const {return _node->value;}
+                pointer operator->() const {return &_node->value;}
+                
+                const_iterator& operator++()
+				{
+                    _node = _node->next;
+	                if (_node == _head) _node = _head->next;
+                   	return *this;
+                }
+                
+                const_iterator operator++(int)
+				{
+                    const_iterator tmp = *this;
+                    ++(*this);
+                    return tmp;
+                }
+                
+                const_iterator& operator--()
+				{
+                    _node = (_node->prev != _head) ? _node->prev : _head->prev;
+                    return *this;
+                }
+                
+                const_iterator operator--(int)
+				{
+                    const_iterator tmp = *this;
+                    --(*this);
+                    return tmp;
+                }
+                
+                bool operator==(const const_iterator& other) const {return _node == other._node;}
+                bool operator!=(const const_iterator& other) const {return _node != other._node;}
+                const node* get_node() const {return _node;}
+                
+            private:
+                const node* _node;
+                const node* _head;
+                friend class circular_list;
+            };
+            
+            typedef size_t size_type;
+            typedef _Tp value_type;
+            typedef _Alloc allocator_type;
+            
+            static const size_type parallel_sort_threshold = 100000;
+            
+            // Round-robin position that survives erasure: if its element is erased
+            // or spliced into another list the cursor moves on to the successor,
+            // and next() wraps past the sentinel. While any cursor is attached,
+            // erase and splice-out also walk the removed range to fix cursors up.
+            // That walk checks every attached cursor at each removed node, so it
+            // costs the range length times the cursor count; lists that erase
+            // long ranges should keep few cursors.
+            class cursor
+            {
+                public:
+                    cursor() noexcept : _list(nullptr),_node(nullptr),_next(nullptr),_prev(nullptr) {}
+                    explicit cursor(circular_list& l) : cursor() {attach(l,l.head->next);}
+                    cursor(circular_list& l,iterator it) : cursor() {attach(l,it.get_node() ? it.get_node() : l.head);}
+                    cursor(const cursor& other) : cursor() {if (other._list) attach(*other._list,other._node);}
+                    
+                    cursor& operator=(const cursor& other)
+                    {
+                        if (this != &other)
+                        {
+                            detach();
+                            if (other._list) attach(*other._list,other._node);
+                        }
+                        return *this;
+                    }
+                    
+                    ~cursor() {detach();}
+                    
+                    bool attached() const noexcept {return _list != nullptr;}
+                    iterator get() const noexcept {return _list ? iterator(_node,_list->head) : iterator();}
+                    
+                    value_type& operator*() const
+                    {
+                        if (!_list || _list->empty()) throw std::out_of_range("List Is Empty!");
+                        return (_node == _list->head ? _node->next : _node)->value;
+                    }
+                    
+                    // Returns the current element and steps to the next one.
+                    value_type& next()
+                    {
+                        if (!_list || _list->empty()) throw std::out_of_range("List Is Empty!");
+                        if (_node == _list->head) _node = _node->next;
+                        value_type& v = _node->value;
+                        _node = _node->next;
+                        return v;
+                    }
+                    
+                    void advance(size_type n = 1)
+                    {
+                        if (!_list || _list->empty()) return;
+                        for (n %= _list->length;n > 0;n--)
+                        {
+                            if (_node == _list->head) _node = _node->next;
+                            _node = _node->next;
+                        }
+                    }
+                    
+                private:
+                    circular_list* _list;
+                    node* _node;
+                    cursor* _next;
+                    cursor* _prev;
+                    
+                    void attach(circular_list& l,node* n)
+                    {
+                        _list = &l;
+                        _node = n;
+                        _prev = nullptr;
+                        _next = l.cursors;
+                        if (_next) _next->_prev = this;
+                        l.cursors = this;
+                    }
+                    
+                    void detach() noexcept
+                    {
+                        if (!_list) return;
+                        if (_prev) _prev->_next = _next;
+                        else _list->cursors = _next;
+                        if (_next) _next->_prev = _prev;
+                        _list = nullptr;
+                        _next = _prev = nullptr;
+                    }
+                    
+                    friend class circular_list;
+            };
+        
+        private:
+            typedef typename std::allocator_traits<_Alloc>::template rebind_alloc<node> node_allocator;
+            typedef std::allocator_traits<node_allocator> node_traits;
+            
+            node_allocator alloc;
+            node* head;
+            size_type length;
+            cursor* cursors;
+            
+            // Moves cursors parked on [first, stop) to stop before those nodes leave.
+            void cursors_leave(node* first,node* stop) noexcept
+            {
+                for (node* n = first;n != stop;n = n->next)
+                    for (cursor* c = cursors;c;c = c->_next) if (c->_node == n) c->_node = stop;
+            }
+            
+            void cursors_reset() noexcept {for (cursor* c = cursors;c;c = c->_next) c->_node = head;}
+            
+            template <typename... Args>
+              node* create_node(node* n,node* p,Args&&... args)
+            {
+                node* ptr = node_traits::allocate(alloc,1);
+                try
+                {
+                    node_traits::construct(alloc,ptr,n,p,std::forward<Args>(args)...);
+                }
+                catch (...)
+                {
+                    node_traits::deallocate(alloc,ptr,1);
+                    throw;
+                }
+                return ptr;
+            }
+            
+            void destroy_node(node* p)
+            {
+                node_traits::destroy(alloc,p);
+                node_traits::deallocate(alloc,p,1);
+            }
+            
+            static node* create_head(node_allocator& a)
+            {
+                node* h = node_traits::allocate(a,1);
+                try
+                {
+                    node_traits::construct(a,h,h,h);
+                }
+                catch (...)
+                {
+                    node_traits::deallocate(a,h,1);
+                    throw;
+                }
+                return h;
+            }
+            
+            node* create_head() {return create_head(alloc);}
+            
+            template <typename... Args>
+              void append_node(node*& chain_first,node*& chain_last,Args&&... args)
+            {
+                node* n = create_node(nullptr,chain_last,std::forward<Args>(args)...);
+                if (chain_last) chain_last->next = n;
+                else chain_first = n;
+                chain_last = n;
+            }
+            
+            void destroy_chain(node* n)
+            {
+                while (n)
+                {
+                    node* next = n->next;
+                    destroy_node(n);
+                    n = next;
+                }
+            }
+            
+            // Moves [first, stop) out of other (possibly *this) to before pos.
+            void transfer(node* pos,circular_list& other,node* first,node* stop,size_type count)
+            {
+                if (!pos) pos = head;
+                if (&other != this && other.cursors) other.cursors_leave(first,stop);
+                node* last_node = stop->prev;
+                first->prev->next = stop;
+                stop->prev = first->prev;
+                first->prev = pos->prev;
+                last_node->next = pos;
+                pos->prev->next = first;
+                pos->prev = last_node;
+                other.length -= count;
+                length += count;
+            }
+            
+            iterator link_chain(node* pos,node* chain_first,node* chain_last,size_type count)
+            {
+                if (!pos) pos = head;
+                if (!chain_first) return iterator(pos,head);
+                chain_first->prev = pos->prev;
+                chain_last->next = pos;
+                pos->prev->next = chain_first;
+                pos->prev = chain_last;
+                length += count;
+                return iterator(chain_first,head);
+            }
+            
+            void copy_alloc(const node_allocator& a,std::true_type) {alloc = a;}
+            void copy_alloc(const node_allocator&,std::false_type) {}
+            // Copies rather than moves: the moved-from list allocates a fresh
+            // sentinel right away and needs a usable allocator for it.
+            void move_alloc(node_allocator& a,std::true_type) {alloc = a;}
+            void move_alloc(node_allocator&,std::false_type) {}
+            
+            // Copies other's elements into one chain and links it in a single step.
+            void append_copy(const circular_list& other)
+            {
+                node* chain_first = nullptr;
+                node* chain_last = nullptr;
+                try
+                {
+                    for (node* curr = other.head->next;curr != other.head;curr = curr->next) append_node(chain_first,chain_last,curr->value);
+                }
+                catch (...)
+                {
+                    destroy_chain(chain_first);
+                    throw;
+                }
+                link_chain(head,chain_first,chain_last,other.length);
+            }
+            
+            // Hands each element to sink as an rvalue and frees its node right
+            // after, so the list shrinks as the destination grows.
+            template <typename Sink>
+              void drain(Sink sink)
+            {
+                if (cursors) cursors_reset();
+                node* curr = head->next;
+                while (curr != head)
+                {
+                    node* next = curr->next;
+                    sink(std::move(curr->value));
+                    head->next = next;
+                    next->prev = head;
+                    length--;
+                    destroy_node(curr);
+                    curr = next;
+                }
+            }
+        
+        public:
+            circular_list() : circular_list(allocator_type()) {}
+            explicit circular_list(const allocator_type& a) : alloc(a),head(nullptr),length(0),cursors(nullptr) {head = create_head();}
+        
+            circular_list(const circular_list& other) : circular_list(std::allocator_traits<_Alloc>::select_on_container_copy_construction(other.get_allocator())) {append_copy(other);}
+            
+            circular_list(size_type count,const value_type& val,const allocator_type& a = allocator_type()) : circular_list(a) {insert(end(),count,val);}
+            
+            template <typename InputIt,typename = std::_RequireInputIter<InputIt> >
+              circular_list(InputIt first,InputIt last,const allocator_type& a = allocator_type()) : circular_list(a) {insert(end(),first,last);}
+        
+#if __cplusplus >= 201103L
+            circular_list(circular_list&& other) noexcept : alloc(other.alloc),head(other.head),length(other.length),cursors(nullptr)
+            {
+                other.head = other.create_head();
+                other.length = 0;
+                other.cursors_reset();
+            }
+            
+            explicit circular_list(size_type count,const allocator_type& a = allocator_type()) : circular_list(a)
+            {
+                node* chain_first = nullptr;
+                node* chain_last = nullptr;
+                try
+                {
+                    for (size_type i = 0;i < count;i++) append_node(chain_first,chain_last);
+                }
+                catch (...)
+                {
+                    destroy_chain(chain_first);
+                    throw;
+                }
+                link_chain(head,chain_first,chain_last,count);
+            }
+            
+            circular_list(std::initializer_list<value_type> init,const allocator_type& a = allocator_type()) : circular_list(a) {insert(end(),init.begin(),init.end());}
+#endif
+        
+            ~circular_list()
+            {
+                clear();
+                destroy_node(head);
+                while (cursors) cursors->detach();
+            }
+        
+            circular_list& operator=(const circular_list& other)
+            {
+                if (this != &other)
+                {
+                    clear();
+                    if (node_traits::propagate_on_container_copy_assignment::value && alloc != other.alloc)
+                    {
+                        // The new sentinel comes from other's allocator before the
+                        // old one is released, so a throw leaves this list intact.
+                        node_allocator replacement(other.alloc);
+                        node* fresh = create_head(replacement);
+                        destroy_node(head);
+                        head = fresh;
+                        copy_alloc(other.alloc,typename node_traits::propagate_on_container_copy_assignment());
+                        cursors_reset();
+                    }
+                    append_copy(other);
+                }
+                return *this;
+            }
+        
+#if __cplusplus >= 201103L
+            circular_list& operator=(circular_list&& other) noexcept(node_traits::propagate_on_container_move_assignment::value || node_traits::is_always_equal::value)
+            {
+                if (this != &other)
+                {
+                    clear();
+                    if (node_traits::propagate_on_container_move_assignment::value || alloc == other.alloc)
+                    {
+                        destroy_node(head);
+                        move_alloc(other.alloc,typename node_traits::propagate_on_container_move_assignment());
+                        head = other.head;
+                        length = other.length;
+                        other.head = other.create_head();
+                        other.length = 0;
+                        cursors_reset();
+                        other.cursors_reset();
+                    }
+                    else
+                    {
+                        node* chain_first = nullptr;
+                        node* chain_last = nullptr;
+                        try
+                        {
+                            for (node* curr = other.head->next;curr != other.head;curr = curr->next) append_node(chain_first,chain_last,std::move(curr->value));
+                        }
+                        catch (...)
+                        {
+                            destroy_chain(chain_first);
+                            throw;
+                        }
+                        link_chain(head,chain_first,chain_last,other.length);
+                        other.clear();
+                    }
+                }
+                return *this;
+            }
+        
+            circular_list& operator=(std::initializer_list<value_type> init_list)
+            {
+                assign(init_list);
+                return *this;
+            }
+#endif
+            
+            allocator_type get_allocator() const noexcept {return allocator_type(alloc);}
+        
+        
+            [[nodiscard]] bool empty() const {return head->next == head;}
+            [[nodiscard]] size_type size() const {return length;}
+        
+            value_type& front()
+            {
+                if (empty()) throw std::out_of_range("List Is Empty!");
+                return head->next->value;
+            }
+            
+            const value_type& front() const
+            {
+                if (empty()) throw std::out_of_range("List Is Empty!");
+                return head->next->value;
+            }
+            
+            value_type& back()
+            {
+                if (empty()) throw std::out_of_range("List Is Empty!");
+                return head->prev->value;
+            }
+            
+            const value_type& back() const
+            {
+                if (empty()) throw std::out_of_range("List Is Empty!");
+                return head->prev->value;
+            }
+        
+            void clear()
+            {
+                node* curr = head->next;
+                while (curr != head)
+                {
+                    node* temp = curr;
+                    curr = curr->next;
+                    destroy_node(temp);
+                }
+                head->next = head;
+                head->prev = head;
+                length = 0;
+                cursors_reset();
+            }
+            
+            void insert(iterator pos,const value_type& val)
+            {
+                node* p = pos.get_node();
+                if (!p || p == head) p = head;
+                node* newNode = create_node(p,p->prev,val);
+                p->prev->next = newNode;
+                p->prev = newNode;
+                length++;
+            }
+            
+#if __cplusplus >= 201103L
+            void insert(iterator pos,value_type&& val)
+            {
+                node* p = pos.get_node();
+                if (!p || p == head) p = head;
+                node* newNode = create_node(p, p->prev,std::move(val));
+                p->prev->next = newNode;
+                p->prev = newNode;
+                length++;
+            }
+#endif
+            void erase(iterator pos)
+            {
+                node* p = pos.get_node();
+                if (!p || p == head) return;
+                if (cursors) cursors_leave(p,p->next);
+                p->prev->next = p->next;
+                p->next->prev = p->prev;
+                destroy_node(p);
+                length--;
+            }
+            
+            void erase(iterator start,iterator end)
+            {
+                node* first = start.get_node();
+                node* stop = end.get_node();
+                if (!first || first == head) return;
+                while (first != stop)
+                {
+                    node* before = first->prev;
+                    node* curr = first;
+                    size_type count = 0;
+                    while (curr != stop && curr != head)
+                    {
+                        curr = curr->next;
+                        count++;
+                    }
+                    if (cursors) cursors_leave(first,curr);
+                    curr->prev->next = nullptr;
+                    before->next = curr;
+                    curr->prev = before;
+                    length -= count;
+                    destroy_chain(first);
+                    if (curr != head || stop == head || head->next == head) break;
+                    first = head->next;
+                }
+            }
+            
+            template <typename InputIt,typename = std::_RequireInputIter<InputIt> >
+              iterator insert(iterator pos,InputIt first,InputIt last)
+            {
+                node* chain_first = nullptr;
+                node* chain_last = nullptr;
+                size_type count = 0;
+                try
+                {
+                    for (;first != last;++first,++count) append_node(chain_first,chain_last,*first);
+                }
+                catch (...)
+                {
+                    destroy_chain(chain_first);
+                    throw;
+                }
+                return link_chain(pos.get_node(),chain_first,chain_last,count);
+            }
+            
+            iterator insert(iterator pos,size_type count,const value_type& val)
+            {
+                node* chain_first = nullptr;
+                node* chain_last = nullptr;
+                try
+                {
+                    for (size_type i = 0;i < count;i++) append_node(chain_first,chain_last,val);
+                }
+                catch (...)
+                {
+                    destroy_chain(chain_first);
+                    throw;
+                }
+                return link_chain(pos.get_node(),chain_first,chain_last,count);
+            }
+            
+#if __cplusplus >= 201103L
+            iterator insert(iterator pos,std::initializer_list<value_type> ilist) {return insert(pos,ilist.begin(),ilist.end());}
+#endif
+            
+            void push_back(const value_type& val) {insert(end(),val);}
+            void push_front(const value_type& val) {insert(begin(),val);}
+#if __cplusplus >= 201103L
+            void push_back(value_type&& val) {insert(end(),std::move(val));}
+            void push_front(value_type&& val) {insert(begin(),std::move(val));}
+#endif
+            
+            void pop_back()
+            {
+                if (empty()) throw std::out_of_range("List Is Empty!");
+                erase(iterator(head->prev, head));
+            }
+            
+            void pop_front()
+            {
+                if (empty()) throw std::out_of_range("List Is Empty!");
+                erase(iterator(head->next, head));
+            }
+        
+            iterator begin() noexcept {return iterator(head->next,head);}
+            iterator end() noexcept {return iterator(head,head);}
+            const_iterator begin() const noexcept {return const_iterator(head->next,head);}
+            const_iterator end() const noexcept {return const_iterator(head, head);}
+            const_iterator cbegin() const noexcept {return begin();}
+            const_iterator cend() const noexcept {return end();}
+            iterator start() noexcept {return begin();}
+            iterator last() noexcept {return iterator(head->prev,head);}
+        
+            void assign(size_type count,const value_type& value)
+            {
+                clear();
+                insert(end(),count,value);
+            }
+        
+            template <typename Iter,typename = std::_RequireInputIter<Iter> >
+              void assign(Iter first,Iter last)
+            {
+                clear();
+                insert(end(),first,last);
+            }
+            
+            void assign(std::initializer_list<value_type> ilist)
+            {
+                clear();
+                insert(end(),ilist.begin(),ilist.end());
+            }
+
+            void resize(size_type new_size)
+            {
+                if (new_size == length) return;
+                if (new_size == 0) clear();
+                else if (new_size < length)
+                {
+                    auto iter = begin();
+                    for (size_type i = 0; i < new_size; i++) ++iter;
+                    erase(iter, end());
+                }
+                else insert(end(),new_size - length,value_type{});
+            }
+            
+#if __cplusplus >= 201103L
+            std::vector<value_type> to_vector() const&
+            {
+                std::vector<value_type> vec;
+                vec.reserve(length);
+                for (node* curr = head->next;curr != head;curr = curr->next) vec.push_back(curr->value);
+                return vec;
+            }
+            
+            std::vector<value_type> to_vector() &&
+            {
+                std::vector<value_type> vec;
+                vec.reserve(length);
+                drain([&vec](value_type&& v) {vec.push_back(std::move(v));});
+                return vec;
+            }
+            
+            template <typename... Args>
+              iterator emplace(iterator pos,Args&&... args)
+            {
+                node* p = pos.get_node();
+                if (!p || p == head) p = head;
+                node* newNode = create_node(p,p->prev,std::forward<Args>(args)...);
+                p->prev->next = newNode;
+                p->prev = newNode;
+                length++;
+                return iterator(newNode,head);
+            }
+            
+            template <typename... Args>
+              void emplace_front(Args&&... args) {emplace(begin(), std::forward<Args>(args)...);}
+            
+            template <typename... Args>
+              void emplace_back(Args&&... args) {emplace(end(), std::forward<Args>(args)...);}
+#endif
+            void sort() {sort([](const value_type& a,const value_type& b) {return a < b;});}
+            
+            // Stable natural merge sort: sorted or strictly descending input costs one
+            // pass. Lists of parallel_sort_threshold nodes or more that are not nearly
+            // sorted are sorted on several threads unless _CIRCULAR_LIST_PARALLEL_SORT
+            // is 0, so the comparator must be safe to call concurrently.
+            template <typename Comp>
+              void sort(Comp c)
+            {
+                if (length < 2) return;
+#if _CIRCULAR_LIST_PARALLEL_SORT
+                if (length >= parallel_sort_threshold)
+                {
+                    unsigned threads = std::thread::hardware_concurrency();
+                    if (threads > 1 && count_runs(c,64) > 64)
+                    {
+                        parallel_sort(c,threads);
+                        return;
+                    }
+                }
+#endif
+                head->prev->next = nullptr;
+                head->next = natural_merge_sort(head->next,c);
+                to_round();
+            }
+            
+            void partial_sort(size_type k) {partial_sort(k,[](const value_type& a,const value_type& b) {return a < b;});}
+            
+            // Moves the k smallest elements to the front in ascending order; the rest
+            // keep their relative order behind them. A max-heap of k node pointers
+            // picks them in one pass, O(n log k); nodes are relinked, not copied.
+            // Like std::partial_sort, equal elements among the k are not kept stable.
+            template <typename Comp>
+              void partial_sort(size_type k,Comp c)
+            {
+                if (k >= length)
+                {
+                    sort(c);
+                    return;
+                }
+                if (k == 0) return;
+                auto less = [&c](const node* a,const node* b) {return c(a->value,b->value);};
+                std::vector<node*> best;
+                best.reserve(k);
+                for (node* n = head->next;n != head;n = n->next)
+                {
+                    if (best.size() < k)
+                    {
+                        best.push_back(n);
+                        std::push_heap(best.begin(),best.end(),less);
+                    }
+                    else if (c(n->value,best.front()->value))
+                    {
+                        std::pop_heap(best.begin(),best.end(),less);
+                        best.back() = n;
+                        std::push_heap(best.begin(),best.end(),less);
+                    }
+                }
+                std::sort_heap(best.begin(),best.end(),less);
+                node* pos = head->next;
+                for (node* n : best)
+                {
+                    if (n == pos)
+                    {
+                        pos = pos->next;
+                        continue;
+                    }
+                    n->prev->next = n->next;
+                    n->next->prev = n->prev;
+                    n->next = pos;
+                    n->prev = pos->prev;
+                    pos->prev->next = n;
+                    pos->prev = n;
+                }
+            }
+            
+            iterator nth_element(size_type n) {return nth_element(n,[](const value_type& a,const value_type& b) {return a < b;});}
+            
+            // Relinks the list so the element at position n is the one a full sort
+            // would put there, with nothing greater before it and nothing smaller
+            // after it, and returns an iterator to it. Quickselect over the node
+            // chain: each round splits the live part three ways around a sampled
+            // pivot, keeping order within each part; O(n) on average.
+            template <typename Comp>
+              iterator nth_element(size_type n,Comp c)
+            {
+                if (n >= length) throw std::out_of_range("Position out of range");
+                node_chain before,after,live;
+                head->prev->next = nullptr;
+                live.first = head->next;
+                live.last = head->prev;
+                live.count = length;
+                size_t seed = length;
+                node* result = nullptr;
+                while (!result)
+                {
+                    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                    node* pivot = live.first;
+                    for (size_type i = (seed >> 17) % live.count;i > 0;i--) pivot = pivot->next;
+                    node_chain lt,eq,gt;
+                    for (node* curr = live.first;curr;)
+                    {
+                        node* next = curr->next;
+                        if (c(curr->value,pivot->value)) lt.append(curr);
+                        else if (c(pivot->value,curr->value)) gt.append(curr);
+                        else eq.append(curr);
+                        curr = next;
+                    }
+                    if (n < lt.count)
+                    {
+                        gt.append(after);
+                        eq.append(gt);
+                        after = eq;
+                        live = lt;
+                    }
+                    else if (n < lt.count + eq.count)
+                    {
+                        result = eq.first;
+                        for (size_type i = n - lt.count;i > 0;i--) result = result->next;
+                        before.append(lt);
+                        before.append(eq);
+                        before.append(gt);
+                    }
+                    else
+                    {
+                        n -= lt.count + eq.count;
+                        before.append(lt);
+                        before.append(eq);
+                        live = gt;
+                    }
+                }
+                before.append(after);
+                head->next = before.first;
+                to_round();
+                return iterator(result,head);
+            }
+            
+            // Makes the element n places from the front the new front (n < 0 rotates
+            // the other way) by relinking the sentinel; no element is touched and
+            // iterators stay valid. Walks min(n, size - n) nodes.
+            void rotate(ptrdiff_t n)
+            {
+                if (length < 2) return;
+                ptrdiff_t len = static_cast<ptrdiff_t>(length);
+                n %= len;
+                if (n < 0) n += len;
+                if (n == 0) return;
+                node* k;
+                if (n <= len / 2)
+                {
+                    k = head->next;
+                    for (ptrdiff_t i = 0;i < n;i++) k = k->next;
+                }
+                else
+                {
+                    k = head;
+                    for (ptrdiff_t i = 0;i < len - n;i++) k = k->prev;
+                }
+                head->prev->next = head->next;
+                head->next->prev = head->prev;
+                head->next = k;
+                head->prev = k->prev;
+                k->prev->next = head;
+                k->prev = head;
+            }
+            
+            void reverse()
+            {
+                if (length < 2) return;
+                node* first = head->next;
+                node* last = head->prev;
+                first->prev = nullptr;
+                last->next = nullptr;
+                node* curr = first;
+                node* prev = nullptr;
+                node* next = nullptr;
+                while (curr)
+                {
+                    next = curr->next;
+                    curr->next = prev;
+                    curr->prev = next;
+                    prev = curr;
+                    curr = next;
+                }
+                head->next = last;
+                head->prev = first;
+                last->prev = head;
+                first->next = head;
+            }
+            
+            template<typename Compare>
+              void remove_if(Compare c)
+            {
+                node* curr = head->next;
+                while (curr != head)
+                {
+                    node* next_node = curr->next;
+                    if (c(curr->value)) erase(iterator(curr,head));
+                    curr = next_node;
+                }
+            }
+
+            void remove(const value_type& remove_val) {remove_if([&](const value_type& a) {return a == remove_val;});}
+            
+            // Splices relink only the boundary nodes; both lists must use equal allocators.
+            // Within one list the destination may be first or last of the range
+            // (nothing moves) but, as with std::list, not strictly inside it.
+            void splice(iterator iter,circular_list& other)
+            {
+                if (&other == this || other.empty()) return;
+                transfer(iter.get_node(),other,other.head->next,other.head,other.length);
+            }
+            
+            void splice(iterator iter,circular_list& other,iterator it)
+            {
+                node* n = it.get_node();
+                if (!n || n == other.head || n == iter.get_node()) return;
+                transfer(iter.get_node(),other,n,n->next,1);
+            }
+            
+            void splice(iterator iter,circular_list& other,iterator first,iterator last)
+            {
+                node* f = first.get_node();
+                node* stop = last.get_node();
+                if (!f || f == other.head || f == stop || f == iter.get_node()) return;
+                size_type count = 0;
+                node* curr = f;
+                for (;curr != stop && curr != other.head;curr = curr->next) count++;
+                transfer(iter.get_node(),other,f,curr,&other == this ? 0 : count);
+            }
+            
+            void splice(iterator iter,circular_list& other,iterator first,iterator last,size_type count)
+            {
+                node* f = first.get_node();
+                if (!f || f == other.head || f == last.get_node() || f == iter.get_node()) return;
+                transfer(iter.get_node(),other,f,last.get_node(),&other == this ? 0 : count);
+            }
+            
+            void merge(circular_list& other) {merge(other,[](const value_type& a,const value_type& b) {return a < b;});}
+            
+            template <typename Compare>
+              void merge(circular_list& other,Compare c)
+            {
+                if (&other == this || other.empty()) return;
+                node* a = head->next;
+                node* b = other.head->next;
+                while (a != head && b != other.head)
+                {
+                    if (c(b->value,a->value))
+                    {
+                        node* next = b->next;
+                        b->prev = a->prev;
+                        b->next = a;
+                        a->prev->next = b;
+                        a->prev = b;
+                        b = next;
+                    }
+                    else a = a->next;
+                }
+                if (b != other.head)
+                {
+                    node* last_node = other.head->prev;
+                    b->prev = head->prev;
+                    last_node->next = head;
+                    head->prev->next = b;
+                    head->prev = last_node;
+                }
+                length += other.length;
+                other.head->next = other.head;
+                other.head->prev = other.head;
+                other.length = 0;
+                other.cursors_reset();
+            }
+            
+            iterator find(const value_type& val)
+            {
+                iterator curr = begin();
+                while (curr != end())
+                {
+                    if (*curr == val) return curr;
+                    ++curr;
+                }
+                return end();
+            }
+            
+            iterator find(iterator start_iter,iterator end_iter,const value_type& val)
+            {
+                iterator curr = start_iter;
+                while (curr != end_iter)
+                {
+                    if (*curr == val) return curr;
+                    ++curr;
+                }
+                return end();
+            }
+            
+            void swap(iterator a, iterator b) noexcept
+            {
+                node* na = a.get_node();
+                node* nb = b.get_node();
+                if (!na || !nb || na == head || nb == head || na == nb) return;
+                std::swap(na->value, nb->value);
+            }
+            
+            // Moves the nodes of [start_iter, end_iter) into a new list; nothing is copied.
+            circular_list split(iterator start_iter,iterator end_iter)
+            {
+                circular_list split_list(get_allocator());
+                node* f = start_iter.get_node();
+                node* stop = end_iter.get_node();
+                if (!f || f == head || f == stop) return split_list;
+                size_type count = 0;
+                node* curr = f;
+                for (;curr != stop && curr != head;curr = curr->next) count++;
+                split_list.transfer(split_list.head,*this,f,curr,count);
+                return split_list;
+            }
+            
+            void unique()
+            {
+                if (length < 2) return;
+                node* curr = head->next->next;
+                while (curr != head)
+                {
+                    node* next = curr->next;
+                    if (curr->value == curr->prev->value) erase(iterator(curr,head));
+                    curr = next;
+                }
+            }
+            
+            size_type max_size() const noexcept {return node_traits::max_size(alloc);}
+            
+            value_type& operator[](int pos)
+            {
+                if (pos < 0 || static_cast<size_type>(pos) >= size()) throw std::out_of_range("Position out of range");
+                iterator curr = begin();
+                for (int i = 0;i < pos;i++) ++curr;
+                return *curr;
+            }
+            
+#if __cplusplus >= 201103L
+            std::list<value_type> to_list() const&
+            {
+                std::list<value_type> lst;
+                for (node* curr = head->next;curr != head;curr = curr->next) lst.push_back(curr->value);
+                return lst;
+            }
+            
+            std::list<value_type> to_list() &&
+            {
+                std::list<value_type> lst;
+                drain([&lst](value_type&& v) {lst.push_back(std::move(v));});
+                return lst;
+            }
+            
+            std::queue<value_type> to_queue() const& {return std::queue<value_type>(to_deque());}
+            std::queue<value_type> to_queue() && {return std::queue<value_type>(std::move(*this).to_deque());}
+            
+            std::forward_list<value_type> to_forward_list() const&
+            {
+                std::forward_list<value_type> fwd_lst;
+                auto before_end = fwd_lst.before_begin();
+                for (node* curr = head->next;curr != head;curr = curr->next) before_end = fwd_lst.insert_after(before_end,curr->value);
+                return fwd_lst;
+            }
+            
+            std::forward_list<value_type> to_forward_list() &&
+            {
+                std::forward_list<value_type> fwd_lst;
+                auto before_end = fwd_lst.before_begin();
+                drain([&](value_type&& v) {before_end = fwd_lst.insert_after(before_end,std::move(v));});
+                return fwd_lst;
+            }
+            
+            std::stack<value_type> to_stack() const& {return std::stack<value_type>(to_deque());}
+            std::stack<value_type> to_stack() && {return std::stack<value_type>(std::move(*this).to_deque());}
+
+            std::deque<value_type> to_deque() const&
+            {
+                std::deque<value_type> deq;
+                for (node* curr = head->next;curr != head;curr = curr->next) deq.push_back(curr->value);
+                return deq;
+            }
+            
+            std::deque<value_type> to_deque() &&
+            {
+                std::deque<value_type> deq;
+                drain([&deq](value_type&& v) {deq.push_back(std::move(v));});
+                return deq;
+            }
+#endif
+        private:
+            // Null-terminated singly linked run of nodes with O(1) append.
+            struct node_chain
+            {
+                node* first;
+                node* last;
+                size_type count;
+                
+                node_chain() : first(nullptr),last(nullptr),count(0) {}
+                
+                void append(node* n)
+                {
+                    n->next = nullptr;
+                    if (last) last->next = n;
+                    else first = n;
+                    last = n;
+                    count++;
+                }
+                
+                void append(const node_chain& other)
+                {
+                    if (!other.first) return;
+                    if (last) last->next = other.first;
+                    else first = other.first;
+                    last = other.last;
+                    count += other.count;
+                }
+            };
+            
+            template <typename Compare>
+              static node* merge_chains(node* a,node* b,Compare& c)
+            {
+                node* result = nullptr;
+                node** tail = &result;
+                while (a && b)
+                {
+                    if (c(b->value,a->value))
+                    {
+                        *tail = b;
+                        b = b->next;
+                    }
+                    else
+                    {
+                        *tail = a;
+                        a = a->next;
+                    }
+                    tail = &(*tail)->next;
+                }
+                *tail = a ? a : b;
+                return result;
+            }
+            
+            // Cuts the null-terminated chain at curr into its first natural run,
+            // reversing it if strictly descending, and advances curr past it.
+            template <typename Compare>
+              static node* take_run(node*& curr,Compare& c)
+            {
+                node* run = curr;
+                node* next = curr->next;
+                if (next && c(next->value,curr->value))
+                {
+                    node* rev = nullptr;
+                    node* n = curr;
+                    do
+                    {
+                        node* nx = n->next;
+                        n->next = rev;
+                        rev = n;
+                        n = nx;
+                    }
+                    while (n && c(n->value,rev->value));
+                    curr = n;
+                    return rev;
+                }
+                while (next && !c(next->value,curr->value))
+                {
+                    curr = next;
+                    next = next->next;
+                }
+                curr->next = nullptr;
+                curr = next;
+                return run;
+            }
+            
+            // Bottom-up merge of natural runs; bins[i] holds the merge of 2^i runs
+            // and always precedes newer runs, which keeps the sort stable.
+            template <typename Compare>
+              static node* natural_merge_sort(node* chain,Compare& c)
+            {
+                node* bins[64] = {};
+                int fill = 0;
+                while (chain)
+                {
+                    node* carry = take_run(chain,c);
+                    int i = 0;
+                    for (;i < fill && bins[i];i++)
+                    {
+                        carry = merge_chains(bins[i],carry,c);
+                        bins[i] = nullptr;
+                    }
+                    bins[i] = carry;
+                    if (i == fill) fill++;
+                }
+                node* sorted = nullptr;
+                for (int i = 0;i < fill;i++) if (bins[i]) sorted = sorted ? merge_chains(bins[i],sorted,c) : bins[i];
+                return sorted;
+            }
+            
+            // Number of natural runs take_run would cut, counting no further than limit + 1.
+            template <typename Compare>
+              size_type count_runs(Compare& c,size_type limit) const
+            {
+                size_type runs = 0;
+                node* n = head->next;
+                while (n != head && runs <= limit)
+                {
+                    runs++;
+                    node* next = n->next;
+                    bool descending = next != head && c(next->value,n->value);
+                    while (next != head && (descending ? c(next->value,n->value) : !c(next->value,n->value)))
+                    {
+                        n = next;
+                        next = n->next;
+                    }
+                    n = next;
+                }
+                return runs;
+            }
+            
+#if _CIRCULAR_LIST_PARALLEL_SORT
+            template <typename Compare>
+              void parallel_sort(Compare& c,unsigned threads)
+            {
+                std::vector<node*> nodes;
+                nodes.reserve(length);
+                for (node* n = head->next;n != head;n = n->next) nodes.push_back(n);
+                auto less = [&c](const node* a,const node* b) {return c(a->value,b->value);};
+                size_type parts = std::min<size_type>(threads,length / (parallel_sort_threshold / 4));
+                std::vector<size_type> bounds(parts + 1);
+                for (size_type i = 0;i <= parts;i++) bounds[i] = length / parts * i + std::min<size_type>(i,length % parts);
+                {
+                    std::vector<std::future<void> > jobs;
+                    for (size_type i = 1;i < parts;i++) jobs.push_back(std::async(std::launch::async,[&,i] {std::stable_sort(nodes.begin() + bounds[i],nodes.begin() + bounds[i + 1],less);}));
+                    std::stable_sort(nodes.begin(),nodes.begin() + bounds[1],less);
+                    for (auto& job : jobs) job.get();
+                }
+                for (size_type width = 1;width < parts;width <<= 1)
+                {
+                    std::vector<std::future<void> > jobs;
+                    for (size_type i = 0;i + width < parts;i += 2 * width)
+                    {
+                        size_type lo = bounds[i];
+                        size_type mid = bounds[i + width];
+                        size_type hi = bounds[std::min(i + 2 * width,parts)];
+                        jobs.push_back(std::async(std::launch::async,[&,lo,mid,hi] {std::inplace_merge(nodes.begin() + lo,nodes.begin() + mid,nodes.begin() + hi,less);}));
+                    }
+                    for (auto& job : jobs) job.get();
+                }
+                node* prev = head;
+                for (node* n : nodes)
+                {
+                    prev->next = n;
+                    n->prev = prev;
+                    prev = n;
+                }
+                prev->next = head;
+                head->prev = prev;
+            }
+#endif
+            
+            void to_round()
+            {
+                if (!head->next) 
+                {
+                    head->next = head;
+                    head->prev = head;
+                    return;
+                }
+                node* curr = head->next;
+                node* prev = head;
+                while (curr && curr != head)
+                {
+                    curr->prev = prev;
+                    prev = curr;
+                    curr = curr->next;
+                }
+                head->next->prev = head;
+                head->prev = prev;
+                prev->next = head;
+            }
+    };
+_GLIBCXX_END_NAMESPACE_CONTAINER
+}
+#if __cplusplus >= 201103L && __has_include(<circular_queue>)
+#include <circular_queue>
+#endif
+#endif
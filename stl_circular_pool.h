@@ -0,0 +1,196 @@
+#ifndef _STL_CIRCULAR_POOL_H_
+#define _STL_CIRCULAR_POOL_H_ 1
+
+#include <cstddef>
+#include <new>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <type_traits>
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_CONTAINER
+    // Fixed-size block pool: carves blocks out of large chunks and keeps
+    // released blocks on an intrusive free list. Thread safe only when built
+    // synchronized, which puts a mutex around every allocate and deallocate.
+    class circular_node_pool
+    {
+        private:
+            struct free_block {free_block* next;};
+
+            size_t block_size;
+            size_t block_align;
+            size_t chunk_blocks;
+            free_block* free_list;
+            std::vector<void*> chunks;
+            bool synchronized;
+            std::mutex lock;
+
+            void* take()
+            {
+                if (!free_list) refill();
+                free_block* b = free_list;
+                free_list = b->next;
+                return b;
+            }
+
+            void give(void* p) noexcept
+            {
+                free_block* b = static_cast<free_block*>(p);
+                b->next = free_list;
+                free_list = b;
+            }
+
+            void refill()
+            {
+                char* chunk = static_cast<char*>(::operator new(block_size * chunk_blocks,std::align_val_t(block_align)));
+                try
+                {
+                    chunks.push_back(chunk);
+                }
+                catch (...)
+                {
+                    ::operator delete(chunk,std::align_val_t(block_align));
+                    throw;
+                }
+                for (size_t i = chunk_blocks;i > 0;i--)
+                {
+                    free_block* b = reinterpret_cast<free_block*>(chunk + (i - 1) * block_size);
+                    b->next = free_list;
+                    free_list = b;
+                }
+            }
+
+        public:
+            circular_node_pool(size_t size,size_t align,size_t blocks,bool sync = false) : block_size(0),block_align(align < alignof(free_block) ? alignof(free_block) : align),chunk_blocks(blocks ? blocks : 1),free_list(nullptr),synchronized(sync)
+            {
+                block_size = size < sizeof(free_block) ? sizeof(free_block) : size;
+                block_size = (block_size + block_align - 1) / block_align * block_align;
+            }
+
+            circular_node_pool(const circular_node_pool&) = delete;
+            circular_node_pool& operator=(const circular_node_pool&) = delete;
+
+            ~circular_node_pool() {for (void* chunk : chunks) ::operator delete(chunk,std::align_val_t(block_align));}
+
+            void* allocate()
+            {
+                if (!synchronized) return take();
+                std::lock_guard<std::mutex> guard(lock);
+                return take();
+            }
+
+            void deallocate(void* p) noexcept
+            {
+                if (!synchronized) return give(p);
+                std::lock_guard<std::mutex> guard(lock);
+                give(p);
+            }
+
+            bool serves(size_t size,size_t align) const noexcept {return size <= block_size && align <= block_align && block_size - size < block_align;}
+            size_t chunk_count() const noexcept {return chunks.size();}
+    };
+
+    // Owns one circular_node_pool per block size requested through it.
+    // Shared by every copy and rebind of a circular_pool_allocator. An
+    // unsynchronized resource must only be used from one thread at a time.
+    class circular_pool_resource
+    {
+        private:
+            size_t chunk_blocks;
+            bool synchronized;
+            std::vector<std::unique_ptr<circular_node_pool> > pools;
+            std::mutex lock;
+
+        public:
+            explicit circular_pool_resource(size_t blocks_per_chunk = 256,bool sync = false) : chunk_blocks(blocks_per_chunk),synchronized(sync) {}
+
+            circular_pool_resource(const circular_pool_resource&) = delete;
+            circular_pool_resource& operator=(const circular_pool_resource&) = delete;
+
+            circular_node_pool* pool_for(size_t size,size_t align)
+            {
+                std::unique_lock<std::mutex> guard(lock,std::defer_lock);
+                if (synchronized) guard.lock();
+                for (auto& p : pools) if (p->serves(size,align)) return p.get();
+                pools.emplace_back(new circular_node_pool(size,align,chunk_blocks,synchronized));
+                return pools.back().get();
+            }
+    };
+
+    // Resource behind every default-constructed circular_pool_allocator: one
+    // unsynchronized resource per thread, so allocation takes no lock and the
+    // default allocators of one thread compare equal (their lists can splice
+    // and swap nodes). A list using it must stay on the thread that built it,
+    // destruction included; lists handed between threads should use
+    // circular_pool_shared_resource() or a synchronized resource of their own.
+    inline const std::shared_ptr<circular_pool_resource>& circular_pool_default_resource()
+    {
+        static thread_local const std::shared_ptr<circular_pool_resource> res = std::make_shared<circular_pool_resource>(256,false);
+        return res;
+    }
+
+    // Opt-in process-wide resource, synchronized: a mutex around every
+    // allocate and deallocate, in exchange for lists that any thread may use.
+    inline const std::shared_ptr<circular_pool_resource>& circular_pool_shared_resource()
+    {
+        static const std::shared_ptr<circular_pool_resource> res = std::make_shared<circular_pool_resource>(256,true);
+        return res;
+    }
+
+    // Allocator for node-based containers such as circular_list: single-object
+    // requests come from the resource's pool, array requests go to std::allocator.
+    // Moving copies, so a moved-from allocator still holds its resource.
+    template<typename _Tp>
+      class circular_pool_allocator
+    {
+        public:
+            typedef _Tp value_type;
+            typedef size_t size_type;
+            typedef ptrdiff_t difference_type;
+            typedef std::true_type propagate_on_container_copy_assignment;
+            typedef std::true_type propagate_on_container_move_assignment;
+            typedef std::true_type propagate_on_container_swap;
+            typedef std::false_type is_always_equal;
+
+            template<typename _Up>
+              struct rebind {typedef circular_pool_allocator<_Up> other;};
+
+            circular_pool_allocator() : circular_pool_allocator(circular_pool_default_resource()) {}
+            explicit circular_pool_allocator(std::shared_ptr<circular_pool_resource> res) : resource(std::move(res)),pool(resource->pool_for(sizeof(_Tp),alignof(_Tp))) {}
+            circular_pool_allocator(const circular_pool_allocator&) = default;
+            circular_pool_allocator& operator=(const circular_pool_allocator&) = default;
+
+            template<typename _Up>
+              circular_pool_allocator(const circular_pool_allocator<_Up>& other) : resource(other.resource),pool(resource->pool_for(sizeof(_Tp),alignof(_Tp))) {}
+
+            _Tp* allocate(size_type n)
+            {
+                if (n == 1) return static_cast<_Tp*>(pool->allocate());
+                return std::allocator<_Tp>().allocate(n);
+            }
+
+            void deallocate(_Tp* p,size_type n) noexcept
+            {
+                if (n == 1) pool->deallocate(p);
+                else std::allocator<_Tp>().deallocate(p,n);
+            }
+
+            const std::shared_ptr<circular_pool_resource>& get_resource() const noexcept {return resource;}
+
+            template<typename _Up>
+              bool operator==(const circular_pool_allocator<_Up>& other) const noexcept {return resource == other.resource;}
+            template<typename _Up>
+              bool operator!=(const circular_pool_allocator<_Up>& other) const noexcept {return resource != other.resource;}
+
+        private:
+            std::shared_ptr<circular_pool_resource> resource;
+            circular_node_pool* pool;
+
+            template<typename _Up>
+              friend class circular_pool_allocator;
+    };
+_GLIBCXX_END_NAMESPACE_CONTAINER
+}
+#endif
@@ -1,70 +1,625 @@
-#if __has_include(<circular_list>)
-#ifndef _STL_CIRCULAR_QUEUE_H_
-#define _STL_CIRCULAR_QUEUE_H_ 1
-
-#include <circular_list>
-
-namespace std
-{
-	template <typename _Tp>
-	  class circular_queue
-	{
-		private:
-		    std::circular_list<_Tp> lst;
-		    size_t capacity;
-		    size_t current_size;
-		
-		public:
-			typedef size_t size_type;
-			typedef _Tp* pointer;
-			typedef _Tp& reference;
-			typedef _Tp value_type;
-			
-		    explicit circular_queue(size_type cap) : capacity(cap),current_size(0) {if (cap == 0) throw std::invalid_argument("Capacity must be at least 1");}
-		
-		    bool enqueue(const value_type& value)
-			{
-		        if (is_full()) return false;
-		        lst.push_back(value);
-		        current_size++;
-		        return true;
-		    }
-		
-		    bool dequeue()
-			{
-		        if (isEmpty()) return false;
-		        lst.pop_front();
-		        current_size--;
-		        return true;
-		    }
-		
-		    value_type front() const
-			{
-		        if (isEmpty()) throw std::runtime_error("Queue is empty");
-		        return lst.front();
-		    }
-		    
-		    value_type rear() const
-			{
-		        if (isEmpty()) throw std::runtime_error("Queue is empty");
-		        return lst.back();
-		    }
-		
-		    bool isEmpty() const {return current_size == 0;}
-		    bool is_full() const {return current_size == capacity;}
-		    size_type size() const {return current_size;}
-		    size_type getcapacity() const {return capacity;}
-		    
-		    void setcapacity(const size_type& size) const
-			{
-				if (size == 0) throw std::runtime_error("Cannot set size to 0");
-				current_size = size;
-				lst.resize(size);
-			}
-			
-			std::circular_list<value_type> to_circular_list() const {return lst;}
-			void sort() {lst.sort();};
-	};
-}
-#endif
-#endif
+#if __has_include(<circular_list>)
+#ifndef _STL_CIRCULAR_QUEUE_H_
+#define _STL_CIRCULAR_QUEUE_H_ 1
+
+#include <circular_list>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#if __cplusplus > 201703L && __has_include(<span>)
+#include <span>
+#endif
+#if __has_include(<sys/uio.h>) && __has_include(<unistd.h>)
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <sys/uio.h>
+#include <unistd.h>
+#define _CIRCULAR_QUEUE_HAS_POSIX_IO 1
+#endif
+
+namespace std
+{
+_GLIBCXX_BEGIN_NAMESPACE_CONTAINER
+	// <circular_list> includes this header from its own end, but only the
+	// declaration is needed here, so the queue also parses when it is reached
+	// before the list is defined. The default allocator is spelled out below
+	// because it is not visible on this declaration.
+	template <typename _Tp,typename _Alloc>
+	  class circular_list;
+_GLIBCXX_END_NAMESPACE_CONTAINER
+
+	inline size_t __circular_round_up_pow2(size_t n)
+	{
+		if (n > (std::numeric_limits<size_t>::max() >> 1) + 1) throw std::length_error("Capacity too large");
+		size_t slots = 1;
+		while (slots < n) slots <<= 1;
+		return slots;
+	}
+
+	// Elements of [first, last) left over when a bulk enqueue fills the queue,
+	// for the rejected counter. A single-pass range cannot be measured without
+	// consuming the caller's input, so it counts as one rejection per call.
+	template <typename InputIt>
+	  size_t __circular_remaining(InputIt,InputIt,std::input_iterator_tag) {return 1;}
+
+	template <typename InputIt>
+	  size_t __circular_remaining(InputIt first,InputIt last,std::forward_iterator_tag) {return std::distance(first,last);}
+
+	// Exported counters of a queue's instrumentation policy. rejected counts
+	// elements turned away, except that enqueue_n over a single-pass input
+	// range adds one per call however many elements it could not take.
+	struct circular_queue_stats
+	{
+		uint64_t enqueues;
+		uint64_t dequeues;
+		uint64_t rejected;
+		uint64_t high_water;
+		uint64_t allocations;
+		uint64_t deallocations;
+	};
+
+	// Default policy: every hook is an empty inline call guarded by 'enabled',
+	// so an uninstrumented queue compiles to the same code as before.
+	struct circular_queue_no_stats
+	{
+		static const bool enabled = false;
+
+		void on_enqueue(size_t,size_t) noexcept {}
+		void on_dequeue(size_t) noexcept {}
+		void on_reject(size_t) noexcept {}
+		void on_allocate() noexcept {}
+		void on_deallocate() noexcept {}
+		circular_queue_stats snapshot() const noexcept {return circular_queue_stats();}
+	};
+
+	// Relaxed atomic counters; snapshot() may be called from any thread while
+	// the queue is in use. Producer- and consumer-side counters sit on separate
+	// cache lines so instrumenting the concurrent queues does not add sharing.
+	struct circular_queue_atomic_stats
+	{
+		static const bool enabled = true;
+
+		alignas(64) std::atomic<uint64_t> enqueues;
+		std::atomic<uint64_t> rejected;
+		std::atomic<uint64_t> high_water;
+		alignas(64) std::atomic<uint64_t> dequeues;
+		alignas(64) std::atomic<uint64_t> allocations;
+		std::atomic<uint64_t> deallocations;
+
+		circular_queue_atomic_stats() noexcept : enqueues(0),rejected(0),high_water(0),dequeues(0),allocations(0),deallocations(0) {}
+		circular_queue_atomic_stats(const circular_queue_atomic_stats& other) noexcept : circular_queue_atomic_stats() {*this = other;}
+
+		circular_queue_atomic_stats& operator=(const circular_queue_atomic_stats& other) noexcept
+		{
+			circular_queue_stats snap = other.snapshot();
+			enqueues.store(snap.enqueues,std::memory_order_relaxed);
+			dequeues.store(snap.dequeues,std::memory_order_relaxed);
+			rejected.store(snap.rejected,std::memory_order_relaxed);
+			high_water.store(snap.high_water,std::memory_order_relaxed);
+			allocations.store(snap.allocations,std::memory_order_relaxed);
+			deallocations.store(snap.deallocations,std::memory_order_relaxed);
+			return *this;
+		}
+
+		void on_enqueue(size_t count,size_t depth) noexcept
+		{
+			enqueues.fetch_add(count,std::memory_order_relaxed);
+			uint64_t seen = high_water.load(std::memory_order_relaxed);
+			while (seen < depth && !high_water.compare_exchange_weak(seen,depth,std::memory_order_relaxed)) {}
+		}
+
+		void on_dequeue(size_t count) noexcept {dequeues.fetch_add(count,std::memory_order_relaxed);}
+		void on_reject(size_t count) noexcept {rejected.fetch_add(count,std::memory_order_relaxed);}
+		void on_allocate() noexcept {allocations.fetch_add(1,std::memory_order_relaxed);}
+		void on_deallocate() noexcept {deallocations.fetch_add(1,std::memory_order_relaxed);}
+
+		circular_queue_stats snapshot() const noexcept
+		{
+			circular_queue_stats snap;
+			snap.enqueues = enqueues.load(std::memory_order_relaxed);
+			snap.dequeues = dequeues.load(std::memory_order_relaxed);
+			snap.rejected = rejected.load(std::memory_order_relaxed);
+			snap.high_water = high_water.load(std::memory_order_relaxed);
+			snap.allocations = allocations.load(std::memory_order_relaxed);
+			snap.deallocations = deallocations.load(std::memory_order_relaxed);
+			return snap;
+		}
+	};
+
+#ifdef _CIRCULAR_QUEUE_HAS_POSIX_IO
+	// Fixed prefix of a circular_queue snapshot, in host byte order. A later
+	// version may only append fields after this prefix and raise version;
+	// readers skip header_size bytes, so they accept any version.
+	struct circular_queue_snapshot_header
+	{
+		uint32_t magic;
+		uint16_t version;
+		uint16_t header_size;
+		uint32_t elem_size;
+		uint32_t reserved;
+		uint64_t count;
+		uint64_t capacity;
+
+		static const uint32_t file_magic = 0x4e534351;
+		static const uint16_t file_version = 1;
+	};
+
+	// Writes every iovec, resuming after short writes; EINTR is retried.
+	inline void __circular_writev_all(int fd,struct iovec* iov,int count)
+	{
+		while (count > 0)
+		{
+			ssize_t n = ::writev(fd,iov,count);
+			if (n < 0)
+			{
+				if (errno == EINTR) continue;
+				throw std::system_error(errno,std::generic_category(),"writev");
+			}
+			size_t done = static_cast<size_t>(n);
+			while (count > 0 && done >= iov->iov_len)
+			{
+				done -= iov->iov_len;
+				iov++;
+				count--;
+			}
+			if (count > 0)
+			{
+				iov->iov_base = static_cast<char*>(iov->iov_base) + done;
+				iov->iov_len -= done;
+			}
+		}
+	}
+
+	inline void __circular_read_all(int fd,void* data,size_t size)
+	{
+		char* p = static_cast<char*>(data);
+		while (size > 0)
+		{
+			ssize_t n = ::read(fd,p,size);
+			if (n < 0)
+			{
+				if (errno == EINTR) continue;
+				throw std::system_error(errno,std::generic_category(),"read");
+			}
+			if (n == 0) throw std::runtime_error("Snapshot is truncated");
+			p += n;
+			size -= static_cast<size_t>(n);
+		}
+	}
+#endif
+
+	// What enqueue does when the queue is full: refuse the new element, or
+	// drop the oldest one to make room (ring log behaviour).
+	enum class circular_overflow {reject,overwrite_oldest};
+
+	// Elements live in one contiguous block of 2^k slots allocated up front;
+	// head and tail are masked indices into it, so enqueue/dequeue never allocate.
+	template <typename _Tp,typename _Stats = circular_queue_no_stats>
+	  class circular_queue : private _Stats
+	{
+		private:
+			_Tp* buffer;
+			size_t mask;
+			size_t head;
+			size_t tail;
+			size_t capacity;
+			size_t current_size;
+			circular_overflow overflow;
+			size_t dropped_count;
+
+			// Overwrite mode on a full queue. The new element is built before the
+			// oldest one is given up, so the arguments may refer to a queued
+			// element and a throwing constructor leaves the queue as it was. A
+			// spare slot at tail takes the element directly; a ring with no spare
+			// slot builds it aside and moves it over the oldest.
+			template <typename... Args>
+			  void replace_oldest(Args&&... args)
+			{
+				if (tail != head)
+				{
+					::new (static_cast<void*>(buffer + tail)) _Tp(std::forward<Args>(args)...);
+					buffer[head].~_Tp();
+				}
+				else
+				{
+					_Tp value(std::forward<Args>(args)...);
+					buffer[head] = std::move(value);
+				}
+				head = (head + 1) & mask;
+				tail = (tail + 1) & mask;
+				dropped_count++;
+			}
+
+			void destroy_all()
+			{
+				for (; current_size > 0; current_size--)
+				{
+					buffer[head].~_Tp();
+					head = (head + 1) & mask;
+				}
+				head = tail = 0;
+			}
+
+			void release()
+			{
+				if (!buffer) return;
+				destroy_all();
+				std::allocator<_Tp>().deallocate(buffer, mask + 1);
+				buffer = nullptr;
+				if (_Stats::enabled) this->on_deallocate();
+			}
+
+			void relocate(size_t slots, size_t keep)
+			{
+				_Tp* fresh = std::allocator<_Tp>().allocate(slots);
+				if (_Stats::enabled) this->on_allocate();
+				size_t moved = 0;
+				try
+				{
+					for (; moved < keep; moved++) ::new (static_cast<void*>(fresh + moved)) _Tp(std::move_if_noexcept(buffer[(head + moved) & mask]));
+				}
+				catch (...)
+				{
+					while (moved > 0) fresh[--moved].~_Tp();
+					std::allocator<_Tp>().deallocate(fresh, slots);
+					if (_Stats::enabled) this->on_deallocate();
+					throw;
+				}
+				release();
+				buffer = fresh;
+				mask = slots - 1;
+				head = 0;
+				tail = keep & mask;
+				current_size = keep;
+			}
+
+		public:
+			typedef size_t size_type;
+			typedef _Tp* pointer;
+			typedef _Tp& reference;
+			typedef _Tp value_type;
+
+			template <bool _Const>
+			  class ring_iterator
+			{
+				public:
+					typedef std::random_access_iterator_tag iterator_category;
+					typedef _Tp value_type;
+					typedef ptrdiff_t difference_type;
+					typedef typename std::conditional<_Const,const _Tp*,_Tp*>::type pointer;
+					typedef typename std::conditional<_Const,const _Tp&,_Tp&>::type reference;
+
+					ring_iterator() : buf(nullptr),mask(0),pos(0) {}
+					ring_iterator(_Tp* b,size_t m,size_t p) : buf(b),mask(m),pos(p) {}
+					template <bool _OtherConst,typename = typename std::enable_if<_Const && !_OtherConst>::type>
+					  ring_iterator(const ring_iterator<_OtherConst>& other) : buf(other.buf),mask(other.mask),pos(other.pos) {}
+
+					reference operator*() const {return buf[pos & mask];}
+					pointer operator->() const {return buf + (pos & mask);}
+					reference operator[](difference_type n) const {return buf[(pos + n) & mask];}
+
+					ring_iterator& operator++() {++pos; return *this;}
+					ring_iterator operator++(int) {ring_iterator tmp = *this; ++pos; return tmp;}
+					ring_iterator& operator--() {--pos; return *this;}
+					ring_iterator operator--(int) {ring_iterator tmp = *this; --pos; return tmp;}
+					ring_iterator& operator+=(difference_type n) {pos += n; return *this;}
+					ring_iterator& operator-=(difference_type n) {pos -= n; return *this;}
+					ring_iterator operator+(difference_type n) const {return ring_iterator(buf,mask,pos + n);}
+					ring_iterator operator-(difference_type n) const {return ring_iterator(buf,mask,pos - n);}
+					friend ring_iterator operator+(difference_type n,const ring_iterator& it) {return it + n;}
+					difference_type operator-(const ring_iterator& other) const {return static_cast<difference_type>(pos - other.pos);}
+
+					bool operator==(const ring_iterator& other) const {return pos == other.pos;}
+					bool operator!=(const ring_iterator& other) const {return pos != other.pos;}
+					bool operator<(const ring_iterator& other) const {return *this - other < 0;}
+					bool operator>(const ring_iterator& other) const {return other < *this;}
+					bool operator<=(const ring_iterator& other) const {return !(other < *this);}
+					bool operator>=(const ring_iterator& other) const {return !(*this < other);}
+
+				private:
+					_Tp* buf;
+					size_t mask;
+					size_t pos;
+					template <bool>
+					  friend class ring_iterator;
+			};
+
+			typedef ring_iterator<false> iterator;
+			typedef ring_iterator<true> const_iterator;
+
+			explicit circular_queue(size_type cap,circular_overflow mode = circular_overflow::reject) : buffer(nullptr),mask(0),head(0),tail(0),capacity(cap),current_size(0),overflow(mode),dropped_count(0)
+			{
+				if (cap == 0) throw std::invalid_argument("Capacity must be at least 1");
+				size_type slots = __circular_round_up_pow2(cap);
+				buffer = std::allocator<_Tp>().allocate(slots);
+				mask = slots - 1;
+				if (_Stats::enabled) this->on_allocate();
+			}
+
+			circular_queue(const circular_queue& other) : circular_queue(other.capacity,other.overflow)
+			{
+				for (size_type i = 0; i < other.current_size; i++) enqueue(other.buffer[(other.head + i) & other.mask]);
+				dropped_count = other.dropped_count;
+			}
+
+			circular_queue(circular_queue&& other) noexcept : _Stats(static_cast<const _Stats&>(other)),buffer(other.buffer),mask(other.mask),head(other.head),tail(other.tail),capacity(other.capacity),current_size(other.current_size),overflow(other.overflow),dropped_count(other.dropped_count)
+			{
+				other.buffer = nullptr;
+				other.mask = other.head = other.tail = other.capacity = other.current_size = other.dropped_count = 0;
+			}
+
+			~circular_queue() {release();}
+
+			circular_queue& operator=(const circular_queue& other)
+			{
+				if (this != &other)
+				{
+					circular_queue tmp(other);
+					*this = std::move(tmp);
+				}
+				return *this;
+			}
+
+			circular_queue& operator=(circular_queue&& other) noexcept
+			{
+				if (this != &other)
+				{
+					release();
+					buffer = other.buffer;
+					mask = other.mask;
+					head = other.head;
+					tail = other.tail;
+					capacity = other.capacity;
+					current_size = other.current_size;
+					overflow = other.overflow;
+					dropped_count = other.dropped_count;
+					_Stats::operator=(static_cast<const _Stats&>(other));
+					other.buffer = nullptr;
+					other.mask = other.head = other.tail = other.capacity = other.current_size = other.dropped_count = 0;
+				}
+				return *this;
+			}
+
+			template <typename... Args>
+			  bool emplace(Args&&... args)
+			{
+				if (current_size == capacity)
+				{
+					if (overflow != circular_overflow::overwrite_oldest || !buffer)
+					{
+						if (_Stats::enabled) this->on_reject(1);
+						return false;
+					}
+					replace_oldest(std::forward<Args>(args)...);
+					if (_Stats::enabled) this->on_enqueue(1,current_size);
+					return true;
+				}
+				::new (static_cast<void*>(buffer + tail)) _Tp(std::forward<Args>(args)...);
+				tail = (tail + 1) & mask;
+				current_size++;
+				if (_Stats::enabled) this->on_enqueue(1,current_size);
+				return true;
+			}
+
+			bool enqueue(const value_type& value) {return emplace(value);}
+			bool enqueue(value_type&& value) {return emplace(std::move(value));}
+
+			template <typename InputIt,typename = std::_RequireInputIter<InputIt> >
+			  size_type enqueue_n(InputIt first,InputIt last)
+			{
+				if (overflow == circular_overflow::overwrite_oldest)
+				{
+					size_type count = 0;
+					for (;first != last;++first,++count) emplace(*first);
+					return count;
+				}
+				size_type room = capacity - current_size;
+				size_type count = 0;
+				try
+				{
+					for (;count < room && first != last;++first,++count) ::new (static_cast<void*>(buffer + ((tail + count) & mask))) _Tp(*first);
+				}
+				catch (...)
+				{
+					tail = (tail + count) & mask;
+					current_size += count;
+					if (_Stats::enabled) this->on_enqueue(count,current_size);
+					throw;
+				}
+				tail = (tail + count) & mask;
+				current_size += count;
+				if (_Stats::enabled)
+				{
+					this->on_enqueue(count,current_size);
+					if (first != last) this->on_reject(__circular_remaining(first,last,typename std::iterator_traits<InputIt>::iterator_category()));
+				}
+				return count;
+			}
+
+#if __cplusplus > 201703L && __has_include(<span>)
+			size_type enqueue_n(std::span<const value_type> values) {return enqueue_n(values.begin(),values.end());}
+#endif
+
+			template <typename OutputIt>
+			  size_type dequeue_n(OutputIt out,size_type n)
+			{
+				size_type count = n < current_size ? n : current_size;
+				for (size_type i = 0;i < count;i++,++out)
+				{
+					*out = std::move(buffer[head]);
+					buffer[head].~_Tp();
+					head = (head + 1) & mask;
+					current_size--;
+				}
+				if (_Stats::enabled) this->on_dequeue(count);
+				return count;
+			}
+
+			bool dequeue()
+			{
+				if (isEmpty()) return false;
+				buffer[head].~_Tp();
+				head = (head + 1) & mask;
+				current_size--;
+				if (_Stats::enabled) this->on_dequeue(1);
+				return true;
+			}
+
+			value_type front() const
+			{
+				if (isEmpty()) throw std::runtime_error("Queue is empty");
+				return buffer[head];
+			}
+
+			value_type rear() const
+			{
+				if (isEmpty()) throw std::runtime_error("Queue is empty");
+				return buffer[(tail - 1) & mask];
+			}
+
+			bool isEmpty() const {return current_size == 0;}
+			bool is_full() const {return current_size == capacity;}
+			size_type size() const {return current_size;}
+			size_type getcapacity() const {return capacity;}
+
+			// Largest capacity setcapacity can accept: the ring is a power of two
+			// slots, and std::allocator must be able to provide that many.
+			size_type max_size() const noexcept
+			{
+				size_type slots = (std::numeric_limits<size_type>::max() >> 1) + 1;
+				while (slots > std::allocator_traits<std::allocator<_Tp> >::max_size(std::allocator<_Tp>())) slots >>= 1;
+				return slots;
+			}
+
+			size_type dropped() const {return dropped_count;}
+			circular_overflow overflow_mode() const {return overflow;}
+			circular_queue_stats stats() const noexcept {return _Stats::snapshot();}
+			void set_overflow_mode(circular_overflow mode) {overflow = mode;}
+
+			iterator begin() noexcept {return iterator(buffer,mask,head);}
+			iterator end() noexcept {return iterator(buffer,mask,head + current_size);}
+			const_iterator begin() const noexcept {return const_iterator(buffer,mask,head);}
+			const_iterator end() const noexcept {return const_iterator(buffer,mask,head + current_size);}
+			const_iterator cbegin() const noexcept {return begin();}
+			const_iterator cend() const noexcept {return end();}
+
+			void setcapacity(const size_type& size)
+			{
+				if (size == 0) throw std::runtime_error("Cannot set size to 0");
+				size_type keep = current_size < size ? current_size : size;
+				relocate(__circular_round_up_pow2(size), keep);
+				capacity = size;
+			}
+
+			std::circular_list<value_type,std::allocator<value_type> > to_circular_list() const&
+			{
+				return std::circular_list<value_type,std::allocator<value_type> >(begin(),end());
+			}
+
+			// Moves the elements into the list and leaves the queue empty.
+			std::circular_list<value_type,std::allocator<value_type> > to_circular_list() &&
+			{
+				std::circular_list<value_type,std::allocator<value_type> > lst(std::make_move_iterator(begin()),std::make_move_iterator(end()));
+				if (_Stats::enabled && current_size) this->on_dequeue(current_size);
+				destroy_all();
+				return lst;
+			}
+
+			void sort()
+			{
+				std::stable_sort(begin(),end());
+			}
+
+			// The live elements as at most two contiguous runs, oldest first:
+			// head to the end of the buffer, then the start of the buffer to tail.
+			// The second run is empty unless the contents wrap.
+			std::pair<pointer,size_type> array_one() noexcept
+			{
+				size_type n = current_size < mask + 1 - head ? current_size : mask + 1 - head;
+				return std::pair<pointer,size_type>(buffer + head,n);
+			}
+
+			std::pair<pointer,size_type> array_two() noexcept
+			{
+				size_type n = array_one().second;
+				return std::pair<pointer,size_type>(buffer,current_size - n);
+			}
+
+			std::pair<const _Tp*,size_type> array_one() const noexcept {return const_cast<circular_queue*>(this)->array_one();}
+			std::pair<const _Tp*,size_type> array_two() const noexcept {return const_cast<circular_queue*>(this)->array_two();}
+
+#if __cplusplus > 201703L && __has_include(<span>)
+			std::span<_Tp> span_one() noexcept {return std::span<_Tp>(array_one().first,array_one().second);}
+			std::span<_Tp> span_two() noexcept {return std::span<_Tp>(array_two().first,array_two().second);}
+			std::span<const _Tp> span_one() const noexcept {return std::span<const _Tp>(array_one().first,array_one().second);}
+			std::span<const _Tp> span_two() const noexcept {return std::span<const _Tp>(array_two().first,array_two().second);}
+#endif
+
+#ifdef _CIRCULAR_QUEUE_HAS_POSIX_IO
+			// Writes a circular_queue_snapshot_header and both runs straight from
+			// the ring with one writev (more only if the kernel writes short).
+			void write_to(int fd) const
+			{
+				static_assert(std::is_trivially_copyable<_Tp>::value,"write_to requires a trivially copyable type");
+				circular_queue_snapshot_header hdr;
+				std::memset(&hdr,0,sizeof(hdr));
+				hdr.magic = circular_queue_snapshot_header::file_magic;
+				hdr.version = circular_queue_snapshot_header::file_version;
+				hdr.header_size = sizeof(hdr);
+				hdr.elem_size = sizeof(_Tp);
+				hdr.count = current_size;
+				hdr.capacity = capacity;
+				std::pair<const _Tp*,size_type> one = array_one();
+				std::pair<const _Tp*,size_type> two = array_two();
+				struct iovec iov[3];
+				iov[0].iov_base = &hdr;
+				iov[0].iov_len = sizeof(hdr);
+				iov[1].iov_base = const_cast<_Tp*>(one.first);
+				iov[1].iov_len = one.second * sizeof(_Tp);
+				iov[2].iov_base = const_cast<_Tp*>(two.first);
+				iov[2].iov_len = two.second * sizeof(_Tp);
+				__circular_writev_all(fd,iov,two.second ? 3 : 2);
+			}
+
+			// Replaces the contents with a snapshot from fd, reading the elements
+			// directly into the buffer. Capacity grows if the snapshot holds more
+			// elements than fit. A header that does not fit this queue is rejected
+			// before the contents are touched; a failure while reading the
+			// elements leaves the queue empty.
+			void read_from(int fd)
+			{
+				static_assert(std::is_trivially_copyable<_Tp>::value,"read_from requires a trivially copyable type");
+				circular_queue_snapshot_header hdr;
+				__circular_read_all(fd,&hdr,sizeof(hdr));
+				if (hdr.magic != circular_queue_snapshot_header::file_magic || hdr.version == 0 || hdr.header_size < sizeof(hdr)) throw std::runtime_error("Not a circular queue snapshot");
+				if (hdr.elem_size != sizeof(_Tp)) throw std::runtime_error("Snapshot element size mismatch");
+				// Checked before count is scaled by sizeof(_Tp) or handed to setcapacity.
+				if (hdr.count > max_size()) throw std::runtime_error("Snapshot element count is too large");
+				for (size_t skip = hdr.header_size - sizeof(hdr);skip > 0;)
+				{
+					char scratch[64];
+					size_t n = skip < sizeof(scratch) ? skip : sizeof(scratch);
+					__circular_read_all(fd,scratch,n);
+					skip -= n;
+				}
+				if (_Stats::enabled && current_size) this->on_dequeue(current_size);
+				destroy_all();
+				if (hdr.count > capacity) setcapacity(hdr.count);
+				__circular_read_all(fd,buffer,hdr.count * sizeof(_Tp));
+				current_size = hdr.count;
+				tail = current_size & mask;
+				if (_Stats::enabled && current_size) this->on_enqueue(current_size,current_size);
+			}
+#endif
+	};
+}
+#endif
+#endif
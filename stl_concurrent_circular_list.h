@@ -0,0 +1,373 @@
+#ifndef _STL_CONCURRENT_CIRCULAR_LIST_H_
+#define _STL_CONCURRENT_CIRCULAR_LIST_H_ 1
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_CONTAINER
+    // Circular list for read-mostly data shared by many threads. Readers open a
+    // read_guard and walk next pointers with acquire loads, taking no lock and
+    // writing only their own reader slot. There is no limit on readers: the slot
+    // registry grows by a block whenever every slot is in use, and each thread
+    // goes back to the slot it used last. Writers are serialised by a mutex and
+    // publish each link with a release store, so a reader always sees a whole
+    // ring, old or new. Erased nodes keep their next pointer and are reclaimed by
+    // epoch: each is tagged with the epoch it was retired in and freed once every
+    // active reader entered in a later epoch. Elements are never modified in place.
+    template<typename _Tp>
+      class concurrent_circular_list
+    {
+        private:
+            struct link
+            {
+                std::atomic<link*> next;
+                link* prev;
+
+                link() : next(nullptr),prev(nullptr) {}
+            };
+
+            struct node : link
+            {
+                node* retired_next;
+                uint64_t retired_epoch;
+                _Tp value;
+
+                template <typename... Args>
+                  explicit node(Args&&... args) : retired_next(nullptr),retired_epoch(0),value(std::forward<Args>(args)...) {}
+            };
+
+            struct alignas(64) reader_slot
+            {
+                std::atomic<uint64_t> epoch;
+            };
+
+            // Reader slots come in blocks chained from reader_blocks. A block is
+            // published once, fully initialised, by a CAS on the chain head and
+            // stays until the list is destroyed, so the registry only grows, to
+            // the largest number of guards ever open at once.
+            static const size_t slots_per_block = 64;
+
+            struct slot_block
+            {
+                reader_slot slots[slots_per_block];
+                slot_block* next;
+            };
+
+            // Each thread remembers the slot it last used in each list it reads,
+            // keyed by a list id that is never reused, so a steady reader claims
+            // the same slot on its own cache line every time.
+            struct slot_cache_entry
+            {
+                uint64_t list_id;
+                reader_slot* slot;
+            };
+
+            static const size_t slot_cache_size = 8;
+            static const uint64_t idle = ~uint64_t(0);
+
+            link head;
+            std::atomic<size_t> length;
+            alignas(64) std::atomic<uint64_t> global_epoch;
+            mutable std::atomic<slot_block*> reader_blocks;
+            const uint64_t id;
+            std::mutex write_lock;
+            node* retired;
+
+            static uint64_t next_list_id()
+            {
+                static std::atomic<uint64_t> counter(0);
+                return counter.fetch_add(1,std::memory_order_relaxed);
+            }
+
+            static slot_cache_entry& cached_slot(uint64_t list_id)
+            {
+                static thread_local slot_cache_entry cache[slot_cache_size] = {};
+                return cache[list_id % slot_cache_size];
+            }
+
+            static bool claim(reader_slot& s,uint64_t epoch) noexcept
+            {
+                uint64_t expected = idle;
+                return s.epoch.load(std::memory_order_relaxed) == idle && s.epoch.compare_exchange_strong(expected,epoch,std::memory_order_seq_cst);
+            }
+
+            // Claims a reader slot for the current epoch: the thread's cached slot
+            // if it is free, else any free slot, else the first slot of a new
+            // block. Never waits for another reader. The fence pairs with the one
+            // in reclaim: either the writer sees this slot, or this reader sees
+            // every unlink made before the writer's scan.
+            reader_slot* enter() const
+            {
+                slot_cache_entry& cache = cached_slot(id);
+                uint64_t epoch = global_epoch.load(std::memory_order_seq_cst);
+                reader_slot* got = nullptr;
+                if (cache.list_id == id && cache.slot && claim(*cache.slot,epoch)) got = cache.slot;
+                for (slot_block* b = reader_blocks.load(std::memory_order_acquire);b && !got;b = b->next)
+                    for (size_t i = 0;i < slots_per_block && !got;i++)
+                        if (claim(b->slots[i],epoch)) got = &b->slots[i];
+                if (!got)
+                {
+                    slot_block* b = new slot_block;
+                    for (size_t i = 1;i < slots_per_block;i++) b->slots[i].epoch.store(idle,std::memory_order_relaxed);
+                    b->slots[0].epoch.store(epoch,std::memory_order_relaxed);
+                    b->next = reader_blocks.load(std::memory_order_relaxed);
+                    while (!reader_blocks.compare_exchange_weak(b->next,b,std::memory_order_seq_cst,std::memory_order_relaxed)) {}
+                    got = &b->slots[0];
+                }
+                cache.list_id = id;
+                cache.slot = got;
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                return got;
+            }
+
+            static void leave(reader_slot* s) noexcept {s->epoch.store(idle,std::memory_order_release);}
+
+            template <typename... Args>
+              void link_before(link* pos,Args&&... args)
+            {
+                node* n = new node(std::forward<Args>(args)...);
+                n->next.store(pos,std::memory_order_relaxed);
+                n->prev = pos->prev;
+                pos->prev->next.store(n,std::memory_order_release);
+                pos->prev = n;
+                length.fetch_add(1,std::memory_order_relaxed);
+            }
+
+            // Unlinks n for new readers; readers already on n can still step past it.
+            void retire(node* n)
+            {
+                link* next = n->next.load(std::memory_order_relaxed);
+                n->prev->next.store(next,std::memory_order_release);
+                next->prev = n->prev;
+                length.fetch_sub(1,std::memory_order_relaxed);
+                n->retired_epoch = global_epoch.fetch_add(1,std::memory_order_seq_cst);
+                n->retired_next = retired;
+                retired = n;
+            }
+
+            // Frees retired nodes no active reader can still reach. Writer lock held.
+            void reclaim()
+            {
+                if (!retired) return;
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                uint64_t oldest = idle;
+                for (slot_block* b = reader_blocks.load(std::memory_order_acquire);b;b = b->next)
+                {
+                    for (size_t i = 0;i < slots_per_block;i++)
+                    {
+                        uint64_t e = b->slots[i].epoch.load(std::memory_order_acquire);
+                        if (e < oldest) oldest = e;
+                    }
+                }
+                node** pos = &retired;
+                while (*pos)
+                {
+                    node* n = *pos;
+                    if (n->retired_epoch < oldest)
+                    {
+                        *pos = n->retired_next;
+                        delete n;
+                    }
+                    else pos = &n->retired_next;
+                }
+            }
+
+        public:
+            typedef _Tp value_type;
+            typedef size_t size_type;
+            typedef const _Tp& const_reference;
+
+            class const_iterator
+            {
+                public:
+                    typedef std::forward_iterator_tag iterator_category;
+                    typedef _Tp value_type;
+                    typedef ptrdiff_t difference_type;
+                    typedef const _Tp* pointer;
+                    typedef const _Tp& reference;
+
+                    const_iterator() : _node(nullptr) {}
+                    explicit const_iterator(const link* n) : _node(n) {}
+                    reference operator*() const {return static_cast<const node*>(_node)->value;}
+                    pointer operator->() const {return &static_cast<const node*>(_node)->value;}
+
+                    const_iterator& operator++()
+                    {
+                        _node = _node->next.load(std::memory_order_acquire);
+                        return *this;
+                    }
+
+                    const_iterator operator++(int)
+                    {
+                        const_iterator tmp = *this;
+                        ++(*this);
+                        return tmp;
+                    }
+
+                    bool operator==(const const_iterator& other) const {return _node == other._node;}
+                    bool operator!=(const const_iterator& other) const {return _node != other._node;}
+
+                private:
+                    const link* _node;
+            };
+
+            // Pins the current epoch; nodes seen through it stay valid until the
+            // guard is destroyed. Keep guards short, they hold back reclamation.
+            class read_guard
+            {
+                public:
+                    explicit read_guard(const concurrent_circular_list& l) : list(&l),slot(l.enter()) {}
+                    read_guard(const read_guard&) = delete;
+                    read_guard& operator=(const read_guard&) = delete;
+                    ~read_guard() {leave(slot);}
+
+                    const_iterator begin() const {return const_iterator(list->head.next.load(std::memory_order_acquire));}
+                    const_iterator end() const {return const_iterator(&list->head);}
+
+                    // Successor of pos on the ring, skipping the sentinel.
+                    const_iterator next(const_iterator pos) const
+                    {
+                        ++pos;
+                        return pos == end() ? begin() : pos;
+                    }
+
+                private:
+                    const concurrent_circular_list* list;
+                    reader_slot* slot;
+            };
+
+            concurrent_circular_list() : length(0),global_epoch(0),reader_blocks(nullptr),id(next_list_id()),retired(nullptr)
+            {
+                head.next.store(&head,std::memory_order_relaxed);
+                head.prev = &head;
+            }
+
+            concurrent_circular_list(const concurrent_circular_list&) = delete;
+            concurrent_circular_list& operator=(const concurrent_circular_list&) = delete;
+
+            // No reader or writer may still be using the list.
+            ~concurrent_circular_list()
+            {
+                link* curr = head.next.load(std::memory_order_relaxed);
+                while (curr != &head)
+                {
+                    link* next = curr->next.load(std::memory_order_relaxed);
+                    delete static_cast<node*>(curr);
+                    curr = next;
+                }
+                while (retired)
+                {
+                    node* next = retired->retired_next;
+                    delete retired;
+                    retired = next;
+                }
+                for (slot_block* b = reader_blocks.load(std::memory_order_relaxed);b;)
+                {
+                    slot_block* next = b->next;
+                    delete b;
+                    b = next;
+                }
+            }
+
+            read_guard read() const {return read_guard(*this);}
+
+            // Writers.
+            template <typename... Args>
+              void emplace_back(Args&&... args)
+            {
+                std::lock_guard<std::mutex> guard(write_lock);
+                link_before(&head,std::forward<Args>(args)...);
+            }
+
+            void push_back(const value_type& val) {emplace_back(val);}
+            void push_back(value_type&& val) {emplace_back(std::move(val));}
+
+            void push_front(const value_type& val)
+            {
+                std::lock_guard<std::mutex> guard(write_lock);
+                link_before(head.next.load(std::memory_order_relaxed),val);
+            }
+
+            // Inserts val before the first element satisfying pred, or at the back.
+            template <typename Pred>
+              void insert_before_if(Pred pred,const value_type& val)
+            {
+                std::lock_guard<std::mutex> guard(write_lock);
+                link* pos = head.next.load(std::memory_order_relaxed);
+                while (pos != &head && !pred(static_cast<const _Tp&>(static_cast<node*>(pos)->value))) pos = pos->next.load(std::memory_order_relaxed);
+                link_before(pos,val);
+            }
+
+            template <typename Pred>
+              size_type remove_if(Pred pred)
+            {
+                std::lock_guard<std::mutex> guard(write_lock);
+                size_type count = 0;
+                link* curr = head.next.load(std::memory_order_relaxed);
+                while (curr != &head)
+                {
+                    link* next = curr->next.load(std::memory_order_relaxed);
+                    if (pred(static_cast<const _Tp&>(static_cast<node*>(curr)->value)))
+                    {
+                        retire(static_cast<node*>(curr));
+                        count++;
+                    }
+                    curr = next;
+                }
+                reclaim();
+                return count;
+            }
+
+            size_type remove(const value_type& val) {return remove_if([&val](const value_type& v) {return v == val;});}
+
+            void clear() {remove_if([](const value_type&) {return true;});}
+
+            // Frees what it can of the nodes erased while readers were active.
+            void collect()
+            {
+                std::lock_guard<std::mutex> guard(write_lock);
+                reclaim();
+            }
+
+            // Readers; each call opens its own guard.
+            template <typename Fn>
+              void for_each(Fn f) const
+            {
+                read_guard g(*this);
+                for (const_iterator it = g.begin();it != g.end();++it) f(*it);
+            }
+
+            template <typename Pred>
+              bool find_if(Pred pred,value_type& out) const
+            {
+                read_guard g(*this);
+                for (const_iterator it = g.begin();it != g.end();++it)
+                {
+                    if (pred(*it))
+                    {
+                        out = *it;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            bool contains(const value_type& val) const
+            {
+                read_guard g(*this);
+                for (const_iterator it = g.begin();it != g.end();++it) if (*it == val) return true;
+                return false;
+            }
+
+            [[nodiscard]] bool empty() const {return size() == 0;}
+            [[nodiscard]] size_type size() const {return length.load(std::memory_order_relaxed);}
+    };
+_GLIBCXX_END_NAMESPACE_CONTAINER
+}
+#endif
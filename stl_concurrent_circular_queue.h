@@ -0,0 +1,850 @@
+#ifndef _STL_CONCURRENT_CIRCULAR_QUEUE_H_
+#define _STL_CONCURRENT_CIRCULAR_QUEUE_H_ 1
+
+#include <circular_queue>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <vector>
+#include <initializer_list>
+
+namespace std
+{
+	inline constexpr size_t __circular_cache_line = 64;
+
+	inline void __circular_cpu_relax(unsigned& spins)
+	{
+		if (++spins < 64)
+		{
+#if defined(__x86_64__) || defined(__i386__)
+			__builtin_ia32_pause();
+#endif
+		}
+		else std::this_thread::yield();
+	}
+
+	// Wait-free ring for exactly one producer thread and one consumer thread.
+	// Each side owns its index on its own cache line and keeps a cached copy of
+	// the other side's index, reloading it only when the ring looks full/empty.
+	template <typename _Tp,typename _Stats = circular_queue_no_stats>
+	  class spsc_circular_queue : private _Stats
+	{
+		private:
+			struct alignas(__circular_cache_line) producer_side
+			{
+				std::atomic<size_t> tail;
+				size_t head_cache;
+			};
+
+			struct alignas(__circular_cache_line) consumer_side
+			{
+				std::atomic<size_t> head;
+				size_t tail_cache;
+			};
+
+			producer_side prod;
+			consumer_side cons;
+			_Tp* buffer;
+			size_t mask;
+			size_t capacity;
+
+		public:
+			typedef size_t size_type;
+			typedef _Tp* pointer;
+			typedef _Tp& reference;
+			typedef _Tp value_type;
+
+			explicit spsc_circular_queue(size_type cap) : buffer(nullptr),mask(0),capacity(cap)
+			{
+				if (cap == 0) throw std::invalid_argument("Capacity must be at least 1");
+				size_type slots = __circular_round_up_pow2(cap);
+				buffer = std::allocator<_Tp>().allocate(slots);
+				mask = slots - 1;
+				if (_Stats::enabled) this->on_allocate();
+				prod.tail.store(0,std::memory_order_relaxed);
+				prod.head_cache = 0;
+				cons.head.store(0,std::memory_order_relaxed);
+				cons.tail_cache = 0;
+			}
+
+			spsc_circular_queue(const spsc_circular_queue&) = delete;
+			spsc_circular_queue& operator=(const spsc_circular_queue&) = delete;
+
+			~spsc_circular_queue()
+			{
+				size_t h = cons.head.load(std::memory_order_relaxed);
+				size_t t = prod.tail.load(std::memory_order_relaxed);
+				for (;h != t;h++) buffer[h & mask].~_Tp();
+				std::allocator<_Tp>().deallocate(buffer,mask + 1);
+				if (_Stats::enabled) this->on_deallocate();
+			}
+
+			// Producer side.
+			template <typename... Args>
+			  bool emplace(Args&&... args)
+			{
+				size_t t = prod.tail.load(std::memory_order_relaxed);
+				if (t - prod.head_cache == capacity)
+				{
+					prod.head_cache = cons.head.load(std::memory_order_acquire);
+					if (t - prod.head_cache == capacity)
+					{
+						if (_Stats::enabled) this->on_reject(1);
+						return false;
+					}
+				}
+				::new (static_cast<void*>(buffer + (t & mask))) _Tp(std::forward<Args>(args)...);
+				prod.tail.store(t + 1,std::memory_order_release);
+				if (_Stats::enabled) this->on_enqueue(1,t + 1 - cons.head.load(std::memory_order_relaxed));
+				return true;
+			}
+
+			bool enqueue(const value_type& value) {return emplace(value);}
+			bool enqueue(value_type&& value) {return emplace(std::move(value));}
+
+			// Consumer side.
+			bool dequeue()
+			{
+				size_t h = cons.head.load(std::memory_order_relaxed);
+				if (h == cons.tail_cache)
+				{
+					cons.tail_cache = prod.tail.load(std::memory_order_acquire);
+					if (h == cons.tail_cache) return false;
+				}
+				buffer[h & mask].~_Tp();
+				cons.head.store(h + 1,std::memory_order_release);
+				if (_Stats::enabled) this->on_dequeue(1);
+				return true;
+			}
+
+			bool dequeue(value_type& out)
+			{
+				size_t h = cons.head.load(std::memory_order_relaxed);
+				if (h == cons.tail_cache)
+				{
+					cons.tail_cache = prod.tail.load(std::memory_order_acquire);
+					if (h == cons.tail_cache) return false;
+				}
+				out = std::move(buffer[h & mask]);
+				buffer[h & mask].~_Tp();
+				cons.head.store(h + 1,std::memory_order_release);
+				if (_Stats::enabled) this->on_dequeue(1);
+				return true;
+			}
+
+			value_type front() const
+			{
+				size_t h = cons.head.load(std::memory_order_relaxed);
+				if (h == prod.tail.load(std::memory_order_acquire)) throw std::runtime_error("Queue is empty");
+				return buffer[h & mask];
+			}
+
+			// Snapshots; exact only when called from a side that is not racing.
+			bool isEmpty() const {return size() == 0;}
+			bool is_full() const {return size() == capacity;}
+			size_type size() const
+			{
+				size_t h = cons.head.load(std::memory_order_acquire);
+				size_t t = prod.tail.load(std::memory_order_acquire);
+				return t - h < capacity ? t - h : capacity;
+			}
+			size_type getcapacity() const {return capacity;}
+			circular_queue_stats stats() const noexcept {return _Stats::snapshot();}
+	};
+
+	// Bounded multi-producer/multi-consumer ring (Vyukov). Every slot carries a
+	// sequence number telling producers and consumers whose turn it is, so the
+	// only shared writes are one CAS on the enqueue or dequeue position.
+	template <typename _Tp,typename _Stats = circular_queue_no_stats>
+	  class mpmc_circular_queue : private _Stats
+	{
+			// A slot is claimed before its value is built; if building threw, the
+			// slot's sequence would never be published and the ring would stall.
+			static_assert(std::is_nothrow_move_constructible<_Tp>::value && std::is_nothrow_destructible<_Tp>::value,"mpmc_circular_queue requires a nothrow move constructible type");
+
+		private:
+			struct cell
+			{
+				std::atomic<size_t> seq;
+				alignas(_Tp) unsigned char storage[sizeof(_Tp)];
+
+				_Tp* value() {return reinterpret_cast<_Tp*>(storage);}
+			};
+
+			alignas(__circular_cache_line) std::atomic<size_t> enqueue_pos;
+			alignas(__circular_cache_line) std::atomic<size_t> dequeue_pos;
+			alignas(__circular_cache_line) cell* cells;
+			size_t mask;
+			size_t capacity;
+
+			size_t index(size_t pos) const {return mask ? pos & mask : pos % capacity;}
+
+			// Anything that might throw is built into a temporary first, before a
+			// slot is claimed, and then moved in.
+			template <typename... Args>
+			  bool do_enqueue(Args&&... args)
+			{
+				if constexpr (!std::is_nothrow_constructible<_Tp,Args&&...>::value) return do_enqueue(_Tp(std::forward<Args>(args)...));
+				size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+				for (;;)
+				{
+					cell& c = cells[index(pos)];
+					size_t seq = c.seq.load(std::memory_order_acquire);
+					ptrdiff_t diff = static_cast<ptrdiff_t>(seq - pos);
+					if (diff == 0)
+					{
+						if (enqueue_pos.compare_exchange_weak(pos,pos + 1,std::memory_order_relaxed))
+						{
+							::new (static_cast<void*>(c.storage)) _Tp(std::forward<Args>(args)...);
+							c.seq.store(pos + 1,std::memory_order_release);
+							if (_Stats::enabled)
+							{
+								ptrdiff_t depth = static_cast<ptrdiff_t>(pos + 1 - dequeue_pos.load(std::memory_order_relaxed));
+								this->on_enqueue(1,depth < 0 ? 0 : depth);
+							}
+							return true;
+						}
+					}
+					else if (diff < 0) return false;
+					else pos = enqueue_pos.load(std::memory_order_relaxed);
+				}
+			}
+
+			template <typename _Fn>
+			  bool do_dequeue(_Fn take)
+			{
+				size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+				for (;;)
+				{
+					cell& c = cells[index(pos)];
+					size_t seq = c.seq.load(std::memory_order_acquire);
+					ptrdiff_t diff = static_cast<ptrdiff_t>(seq - (pos + 1));
+					if (diff == 0)
+					{
+						if (dequeue_pos.compare_exchange_weak(pos,pos + 1,std::memory_order_relaxed))
+						{
+							take(*c.value());
+							c.value()->~_Tp();
+							c.seq.store(pos + capacity,std::memory_order_release);
+							if (_Stats::enabled) this->on_dequeue(1);
+							return true;
+						}
+					}
+					else if (diff < 0) return false;
+					else pos = dequeue_pos.load(std::memory_order_relaxed);
+				}
+			}
+
+			bool counted(bool accepted)
+			{
+				if (_Stats::enabled && !accepted) this->on_reject(1);
+				return accepted;
+			}
+
+		public:
+			typedef size_t size_type;
+			typedef _Tp* pointer;
+			typedef _Tp& reference;
+			typedef _Tp value_type;
+
+			explicit mpmc_circular_queue(size_type cap) : cells(nullptr),mask(0),capacity(cap)
+			{
+				if (cap == 0) throw std::invalid_argument("Capacity must be at least 1");
+				cells = new cell[cap];
+				if (_Stats::enabled) this->on_allocate();
+				if ((cap & (cap - 1)) == 0) mask = cap - 1;
+				for (size_type i = 0;i < cap;i++) cells[i].seq.store(i,std::memory_order_relaxed);
+				enqueue_pos.store(0,std::memory_order_relaxed);
+				dequeue_pos.store(0,std::memory_order_relaxed);
+			}
+
+			mpmc_circular_queue(const mpmc_circular_queue&) = delete;
+			mpmc_circular_queue& operator=(const mpmc_circular_queue&) = delete;
+
+			~mpmc_circular_queue()
+			{
+				while (dequeue()) {}
+				delete[] cells;
+				if (_Stats::enabled) this->on_deallocate();
+			}
+
+			bool try_enqueue(const value_type& value) {return counted(do_enqueue(value));}
+			bool try_enqueue(value_type&& value) {return counted(do_enqueue(std::move(value)));}
+			bool try_dequeue(value_type& out)
+			{
+				static_assert(std::is_nothrow_move_assignable<_Tp>::value,"try_dequeue(out) requires a nothrow move assignable type");
+				return do_dequeue([&](value_type& v) {out = std::move(v);});
+			}
+
+			void spin_enqueue(const value_type& value)
+			{
+				if constexpr (!std::is_nothrow_copy_constructible<_Tp>::value) spin_enqueue(_Tp(value));
+				else for (unsigned spins = 0;!do_enqueue(value);) __circular_cpu_relax(spins);
+			}
+
+			void spin_enqueue(value_type&& value)
+			{
+				for (unsigned spins = 0;!do_enqueue(std::move(value));) __circular_cpu_relax(spins);
+			}
+
+			void spin_dequeue(value_type& out)
+			{
+				for (unsigned spins = 0;!try_dequeue(out);) __circular_cpu_relax(spins);
+			}
+
+			bool enqueue(const value_type& value) {return try_enqueue(value);}
+			bool enqueue(value_type&& value) {return try_enqueue(std::move(value));}
+			bool dequeue(value_type& out) {return try_dequeue(out);}
+			bool dequeue() {return do_dequeue([](value_type&) {});}
+
+			// Snapshots; may be stale by the time the caller looks at them.
+			bool isEmpty() const {return size() == 0;}
+			bool is_full() const {return size() == capacity;}
+			size_type size() const
+			{
+				size_t h = dequeue_pos.load(std::memory_order_acquire);
+				size_t t = enqueue_pos.load(std::memory_order_acquire);
+				if (static_cast<ptrdiff_t>(t - h) < 0) return 0;
+				return t - h < capacity ? t - h : capacity;
+			}
+			size_type getcapacity() const {return capacity;}
+			circular_queue_stats stats() const noexcept {return _Stats::snapshot();}
+	};
+
+	// circular_queue guarded by a mutex whose push/pop park the caller while the
+	// queue is full/empty. Callers spin briefly on a lock-free size before
+	// parking. Wakeups are chained rather than broadcast: a producer only
+	// notifies on the empty->non-empty edge, and each woken consumer wakes the
+	// next one if items remain, so a burst costs one notify, not one per element.
+	template <typename _Tp,typename _Stats = circular_queue_no_stats>
+	  class blocking_circular_queue
+	{
+		private:
+			static const unsigned spin_limit = 64;
+
+			mutable std::mutex lock;
+			std::condition_variable not_empty;
+			std::condition_variable not_full;
+			circular_queue<_Tp,_Stats> ring;
+			std::atomic<size_t> count;
+			std::atomic<bool> closed;
+			size_t waiting_consumers;
+			size_t waiting_producers;
+
+			void spin_while(bool for_items) const
+			{
+				for (unsigned spins = 0;spins < spin_limit && !closed.load(std::memory_order_relaxed);)
+				{
+					size_t n = count.load(std::memory_order_relaxed);
+					if (for_items ? n != 0 : n < ring.getcapacity()) return;
+					__circular_cpu_relax(spins);
+				}
+			}
+
+			// Called with the lock held after the ring changed; returns which
+			// condition variables need a notify once the lock is released.
+			void settle(size_t before,bool& wake_consumer,bool& wake_producer)
+			{
+				size_t after = ring.size();
+				count.store(after,std::memory_order_relaxed);
+				wake_consumer = waiting_consumers > 0 && after > 0 && (before == 0 || after < before);
+				wake_producer = waiting_producers > 0 && after < ring.getcapacity() && (before == ring.getcapacity() || after > before);
+			}
+
+			void notify(bool wake_consumer,bool wake_producer)
+			{
+				if (wake_consumer) not_empty.notify_one();
+				if (wake_producer) not_full.notify_one();
+			}
+
+			template <typename _Up>
+			  bool do_push(_Up&& value,std::unique_lock<std::mutex>& guard)
+			{
+				size_t before = ring.size();
+				bool ok = ring.enqueue(std::forward<_Up>(value));
+				bool wake_consumer,wake_producer;
+				settle(before,wake_consumer,wake_producer);
+				guard.unlock();
+				notify(wake_consumer,wake_producer);
+				return ok;
+			}
+
+			bool do_pop(_Tp& out,std::unique_lock<std::mutex>& guard)
+			{
+				size_t before = ring.size();
+				ring.dequeue_n(&out,1);
+				bool wake_consumer,wake_producer;
+				settle(before,wake_consumer,wake_producer);
+				guard.unlock();
+				notify(wake_consumer,wake_producer);
+				return true;
+			}
+
+			template <typename _Up>
+			  bool wait_push(_Up&& value)
+			{
+				spin_while(false);
+				std::unique_lock<std::mutex> guard(lock);
+				if (ring.is_full() && !closed.load(std::memory_order_relaxed))
+				{
+					waiting_producers++;
+					not_full.wait(guard,[this] {return !ring.is_full() || closed.load(std::memory_order_relaxed);});
+					waiting_producers--;
+				}
+				if (closed.load(std::memory_order_relaxed)) return false;
+				return do_push(std::forward<_Up>(value),guard);
+			}
+
+		public:
+			typedef size_t size_type;
+			typedef _Tp* pointer;
+			typedef _Tp& reference;
+			typedef _Tp value_type;
+
+			explicit blocking_circular_queue(size_type cap) : ring(cap),count(0),closed(false),waiting_consumers(0),waiting_producers(0) {}
+
+			blocking_circular_queue(const blocking_circular_queue&) = delete;
+			blocking_circular_queue& operator=(const blocking_circular_queue&) = delete;
+
+			// Blocks while full; returns false once the queue is closed.
+			bool push(const value_type& value) {return wait_push(value);}
+			bool push(value_type&& value) {return wait_push(std::move(value));}
+
+			bool try_push(const value_type& value)
+			{
+				std::unique_lock<std::mutex> guard(lock);
+				if (closed.load(std::memory_order_relaxed) || ring.is_full()) return false;
+				return do_push(value,guard);
+			}
+
+			// Blocks while empty; returns false once the queue is closed and drained.
+			bool pop(value_type& out)
+			{
+				spin_while(true);
+				std::unique_lock<std::mutex> guard(lock);
+				if (ring.isEmpty() && !closed.load(std::memory_order_relaxed))
+				{
+					waiting_consumers++;
+					not_empty.wait(guard,[this] {return !ring.isEmpty() || closed.load(std::memory_order_relaxed);});
+					waiting_consumers--;
+				}
+				if (ring.isEmpty()) return false;
+				return do_pop(out,guard);
+			}
+
+			bool try_pop(value_type& out)
+			{
+				std::unique_lock<std::mutex> guard(lock);
+				if (ring.isEmpty()) return false;
+				return do_pop(out,guard);
+			}
+
+			template <typename _Rep,typename _Period>
+			  bool try_pop_for(value_type& out,const std::chrono::duration<_Rep,_Period>& timeout)
+			{
+				spin_while(true);
+				std::unique_lock<std::mutex> guard(lock);
+				if (ring.isEmpty() && !closed.load(std::memory_order_relaxed))
+				{
+					waiting_consumers++;
+					not_empty.wait_for(guard,timeout,[this] {return !ring.isEmpty() || closed.load(std::memory_order_relaxed);});
+					waiting_consumers--;
+				}
+				if (ring.isEmpty()) return false;
+				return do_pop(out,guard);
+			}
+
+			// Waits for at least one element, then takes up to n under one lock.
+			template <typename OutputIt>
+			  size_type pop_n(OutputIt out,size_type n)
+			{
+				if (n == 0) return 0;
+				spin_while(true);
+				std::unique_lock<std::mutex> guard(lock);
+				if (ring.isEmpty() && !closed.load(std::memory_order_relaxed))
+				{
+					waiting_consumers++;
+					not_empty.wait(guard,[this] {return !ring.isEmpty() || closed.load(std::memory_order_relaxed);});
+					waiting_consumers--;
+				}
+				size_t before = ring.size();
+				size_type taken = ring.dequeue_n(out,n);
+				bool wake_consumer,wake_producer;
+				settle(before,wake_consumer,wake_producer);
+				guard.unlock();
+				notify(wake_consumer,wake_producer);
+				return taken;
+			}
+
+			// Wakes every waiter; later pushes fail and pops drain what is left.
+			void close()
+			{
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					closed.store(true,std::memory_order_relaxed);
+				}
+				not_empty.notify_all();
+				not_full.notify_all();
+			}
+
+			bool is_closed() const {return closed.load(std::memory_order_relaxed);}
+			bool isEmpty() const {return size() == 0;}
+			bool is_full() const {return size() == ring.getcapacity();}
+			size_type size() const {return count.load(std::memory_order_relaxed);}
+			size_type getcapacity() const {return ring.getcapacity();}
+
+			circular_queue_stats stats() const
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				return ring.stats();
+			}
+	};
+
+	// Chase-Lev work-stealing deque (Le, Pop, Cohen, Zappa Nardelli's C11
+	// formulation). The owning thread pushes and pops at the bottom with plain
+	// loads and stores plus one fence; any thread may steal from the top with a
+	// single CAS. When full the owner copies the live range into a ring twice the
+	// size and publishes it; stealers still reading the old ring see the same
+	// values there, so retired rings are kept until the deque is destroyed.
+	// Slots are read racily by thieves, hence the trivially copyable requirement,
+	// and held as std::atomic<_Tp>, which must be lock-free: a locked atomic
+	// would need -latomic and would serialise every steal on its mutex.
+	template <typename _Tp,typename _Stats = circular_queue_no_stats>
+	  class work_stealing_deque : private _Stats
+	{
+			static_assert(std::is_trivially_copyable<_Tp>::value,"work_stealing_deque requires a trivially copyable type");
+			static_assert(std::atomic<_Tp>::is_always_lock_free,"work_stealing_deque requires a type whose std::atomic is lock-free");
+
+		private:
+			struct ring
+			{
+				int64_t mask;
+				std::atomic<_Tp>* slots;
+				ring* retired;
+
+				explicit ring(int64_t size) : mask(size - 1),slots(new std::atomic<_Tp>[size]),retired(nullptr) {}
+				~ring() {delete[] slots;}
+
+				_Tp get(int64_t i) const noexcept {return slots[i & mask].load(std::memory_order_relaxed);}
+				void put(int64_t i,const _Tp& value) noexcept {slots[i & mask].store(value,std::memory_order_relaxed);}
+			};
+
+			alignas(__circular_cache_line) std::atomic<int64_t> top;
+			alignas(__circular_cache_line) std::atomic<int64_t> bottom;
+			std::atomic<ring*> array;
+
+			ring* grow(ring* old,int64_t b,int64_t t)
+			{
+				ring* bigger = new ring((old->mask + 1) * 2);
+				if (_Stats::enabled) this->on_allocate();
+				for (int64_t i = t;i < b;i++) bigger->put(i,old->get(i));
+				bigger->retired = old;
+				array.store(bigger,std::memory_order_release);
+				return bigger;
+			}
+
+		public:
+			typedef size_t size_type;
+			typedef _Tp* pointer;
+			typedef _Tp& reference;
+			typedef _Tp value_type;
+
+			explicit work_stealing_deque(size_type cap = 64)
+			{
+				if (cap == 0) throw std::invalid_argument("Capacity must be at least 1");
+				array.store(new ring(static_cast<int64_t>(__circular_round_up_pow2(cap))),std::memory_order_relaxed);
+				if (_Stats::enabled) this->on_allocate();
+				top.store(0,std::memory_order_relaxed);
+				bottom.store(0,std::memory_order_relaxed);
+			}
+
+			work_stealing_deque(const work_stealing_deque&) = delete;
+			work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+			~work_stealing_deque()
+			{
+				ring* r = array.load(std::memory_order_relaxed);
+				while (r)
+				{
+					ring* next = r->retired;
+					delete r;
+					if (_Stats::enabled) this->on_deallocate();
+					r = next;
+				}
+			}
+
+			// Owner thread only.
+			void push(const value_type& value)
+			{
+				int64_t b = bottom.load(std::memory_order_relaxed);
+				int64_t t = top.load(std::memory_order_acquire);
+				ring* a = array.load(std::memory_order_relaxed);
+				if (b - t > a->mask) a = grow(a,b,t);
+				a->put(b,value);
+				std::atomic_thread_fence(std::memory_order_release);
+				bottom.store(b + 1,std::memory_order_relaxed);
+				if (_Stats::enabled) this->on_enqueue(1,static_cast<size_t>(b + 1 - t));
+			}
+
+			// Owner thread only; takes the most recently pushed element. When one
+			// element is left the owner races the thieves for it with the same CAS.
+			bool pop(value_type& out)
+			{
+				int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+				ring* a = array.load(std::memory_order_relaxed);
+				bottom.store(b,std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				int64_t t = top.load(std::memory_order_relaxed);
+				if (t > b)
+				{
+					bottom.store(b + 1,std::memory_order_relaxed);
+					return false;
+				}
+				out = a->get(b);
+				if (t == b)
+				{
+					bool won = top.compare_exchange_strong(t,t + 1,std::memory_order_seq_cst,std::memory_order_relaxed);
+					bottom.store(b + 1,std::memory_order_relaxed);
+					if (!won) return false;
+				}
+				if (_Stats::enabled) this->on_dequeue(1);
+				return true;
+			}
+
+			// Any thread; takes the oldest element. Fails if the deque looked empty
+			// or another thief (or the owner) won the race for the same element.
+			bool try_steal(value_type& out)
+			{
+				int64_t t = top.load(std::memory_order_acquire);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				int64_t b = bottom.load(std::memory_order_acquire);
+				if (t >= b) return false;
+				ring* a = array.load(std::memory_order_acquire);
+				value_type value = a->get(t);
+				if (!top.compare_exchange_strong(t,t + 1,std::memory_order_seq_cst,std::memory_order_relaxed)) return false;
+				out = value;
+				if (_Stats::enabled) this->on_dequeue(1);
+				return true;
+			}
+
+			// Any thread; retries lost races and fails only when the deque is empty.
+			bool steal(value_type& out)
+			{
+				for (unsigned spins = 0;;__circular_cpu_relax(spins))
+				{
+					if (try_steal(out)) return true;
+					if (isEmpty()) return false;
+				}
+			}
+
+			// Snapshots; may be stale by the time the caller looks at them.
+			bool isEmpty() const {return size() == 0;}
+			size_type size() const
+			{
+				int64_t t = top.load(std::memory_order_acquire);
+				int64_t b = bottom.load(std::memory_order_acquire);
+				return b > t ? static_cast<size_type>(b - t) : 0;
+			}
+			size_type getcapacity() const {return static_cast<size_type>(array.load(std::memory_order_acquire)->mask + 1);}
+			circular_queue_stats stats() const noexcept {return _Stats::snapshot();}
+	};
+
+	// Single-writer ring read in full by every registered consumer. Each
+	// consumer owns a sequence cursor on its own cache line and may name
+	// upstream consumers it must stay behind, so stages form a pipeline over one
+	// shared buffer. The writer reuses a slot only once the slowest consumer has
+	// moved past it. Register consumers before the writer starts publishing.
+	// Every consumer reads every element, so the dequeues counter of the
+	// stats policy counts deliveries: one per element per consumer.
+	template <typename _Tp,typename _Stats = circular_queue_no_stats>
+	  class broadcast_circular_queue : private _Stats
+	{
+		public:
+			typedef size_t size_type;
+			typedef _Tp* pointer;
+			typedef _Tp& reference;
+			typedef _Tp value_type;
+
+			class consumer
+			{
+				private:
+					friend class broadcast_circular_queue;
+
+					alignas(__circular_cache_line) std::atomic<size_t> cursor;
+					size_t limit_cache;
+					broadcast_circular_queue* ring;
+					std::vector<const consumer*> upstream;
+
+					consumer(broadcast_circular_queue* r,std::vector<const consumer*> deps,size_t start) : limit_cache(start),ring(r),upstream(std::move(deps)) {cursor.store(start,std::memory_order_relaxed);}
+
+					// First sequence this consumer may not read yet: the writer's
+					// published count, capped by every upstream cursor.
+					size_t limit() const
+					{
+						size_t lim = ring->published.load(std::memory_order_acquire);
+						for (const consumer* c : upstream)
+						{
+							size_t s = c->cursor.load(std::memory_order_acquire);
+							if (s < lim) lim = s;
+						}
+						return lim;
+					}
+
+				public:
+					consumer(const consumer&) = delete;
+					consumer& operator=(const consumer&) = delete;
+
+					size_type available()
+					{
+						size_t cur = cursor.load(std::memory_order_relaxed);
+						if (limit_cache == cur) limit_cache = limit();
+						return limit_cache - cur;
+					}
+
+					// Hands up to max readable elements to f(const _Tp&) and releases
+					// them with a single cursor store. They count as dequeues for this
+					// consumer only; the slots stay live for the others.
+					template <typename _Fn>
+					  size_type consume(_Fn f,size_type max = static_cast<size_type>(-1))
+					{
+						size_t cur = cursor.load(std::memory_order_relaxed);
+						size_type n = available();
+						if (n > max) n = max;
+						for (size_type i = 0;i < n;i++) f(static_cast<const _Tp&>(ring->slots[(cur + i) & ring->mask]));
+						if (n)
+						{
+							cursor.store(cur + n,std::memory_order_release);
+							if (_Stats::enabled) ring->on_dequeue(n);
+						}
+						return n;
+					}
+
+					// As consume, but first waits until at least one element is readable.
+					template <typename _Fn>
+					  size_type spin_consume(_Fn f,size_type max = static_cast<size_type>(-1))
+					{
+						for (unsigned spins = 0;available() == 0;) __circular_cpu_relax(spins);
+						return consume(f,max);
+					}
+
+					bool try_dequeue(value_type& out) {return consume([&out](const _Tp& v) {out = v;},1) == 1;}
+
+					size_type sequence() const {return cursor.load(std::memory_order_acquire);}
+			};
+
+		private:
+			alignas(__circular_cache_line) std::atomic<size_t> published;
+			size_t gate_cache;
+			std::unique_ptr<_Tp[]> slots;
+			size_t mask;
+			size_t capacity;
+			std::vector<std::unique_ptr<consumer> > consumers;
+
+			size_t slowest() const
+			{
+				size_t low = published.load(std::memory_order_relaxed);
+				for (const std::unique_ptr<consumer>& c : consumers)
+				{
+					size_t s = c->cursor.load(std::memory_order_acquire);
+					if (s < low) low = s;
+				}
+				return low;
+			}
+
+			size_type room(size_t p)
+			{
+				if (p - gate_cache >= capacity) gate_cache = slowest();
+				return capacity - (p - gate_cache);
+			}
+
+			// Uncounted, so spin_enqueue does not log a rejection per retry.
+			template <typename _Up>
+			  bool do_enqueue(_Up&& value)
+			{
+				size_t p = published.load(std::memory_order_relaxed);
+				if (room(p) == 0) return false;
+				slots[p & mask] = std::forward<_Up>(value);
+				published.store(p + 1,std::memory_order_release);
+				if (_Stats::enabled) this->on_enqueue(1,p + 1 - gate_cache);
+				return true;
+			}
+
+			bool counted(bool accepted)
+			{
+				if (_Stats::enabled && !accepted) this->on_reject(1);
+				return accepted;
+			}
+
+		public:
+			explicit broadcast_circular_queue(size_type cap) : gate_cache(0),mask(0),capacity(cap)
+			{
+				if (cap == 0) throw std::invalid_argument("Capacity must be at least 1");
+				size_type n = __circular_round_up_pow2(cap);
+				slots.reset(new _Tp[n]);
+				mask = n - 1;
+				if (_Stats::enabled) this->on_allocate();
+				published.store(0,std::memory_order_relaxed);
+			}
+
+			broadcast_circular_queue(const broadcast_circular_queue&) = delete;
+			broadcast_circular_queue& operator=(const broadcast_circular_queue&) = delete;
+
+			~broadcast_circular_queue()
+			{
+				if (_Stats::enabled) this->on_deallocate();
+			}
+
+			// Registers a consumer that starts at the next published element and
+			// never overtakes any consumer in upstream.
+			consumer& add_consumer(std::initializer_list<const consumer*> upstream = {})
+			{
+				consumers.push_back(std::unique_ptr<consumer>(new consumer(this,std::vector<const consumer*>(upstream),published.load(std::memory_order_relaxed))));
+				return *consumers.back();
+			}
+
+			// Writer side.
+			bool try_enqueue(const value_type& value) {return counted(do_enqueue(value));}
+			bool try_enqueue(value_type&& value) {return counted(do_enqueue(std::move(value)));}
+
+			// Writes as many elements as fit and publishes them with one store.
+			template <typename InputIt,typename = std::_RequireInputIter<InputIt> >
+			  size_type try_enqueue_n(InputIt first,InputIt last)
+			{
+				size_t p = published.load(std::memory_order_relaxed);
+				size_type free_slots = room(p);
+				size_type n = 0;
+				for (;n < free_slots && first != last;++first,++n) slots[(p + n) & mask] = *first;
+				if (n) published.store(p + n,std::memory_order_release);
+				if (_Stats::enabled)
+				{
+					if (n) this->on_enqueue(n,p + n - gate_cache);
+					if (first != last) this->on_reject(__circular_remaining(first,last,typename std::iterator_traits<InputIt>::iterator_category()));
+				}
+				return n;
+			}
+
+			void spin_enqueue(const value_type& value)
+			{
+				for (unsigned spins = 0;!do_enqueue(value);) __circular_cpu_relax(spins);
+			}
+
+			void spin_enqueue(value_type&& value)
+			{
+				for (unsigned spins = 0;!do_enqueue(std::move(value));) __circular_cpu_relax(spins);
+			}
+
+			// Snapshots; may be stale by the time the caller looks at them.
+			size_type size() const {return published.load(std::memory_order_acquire) - slowest();}
+			bool isEmpty() const {return size() == 0;}
+			bool is_full() const {return size() == capacity;}
+			size_type getcapacity() const {return capacity;}
+			size_type sequence() const {return published.load(std::memory_order_acquire);}
+			circular_queue_stats stats() const noexcept {return _Stats::snapshot();}
+	};
+}
+#endif
@@ -0,0 +1,352 @@
+#ifndef _STL_INTRUSIVE_CIRCULAR_LIST_H_
+#define _STL_INTRUSIVE_CIRCULAR_LIST_H_ 1
+
+#include <cstddef>
+#include <stdexcept>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_CONTAINER
+    // Link embedded in a user object. Copying an object never copies its links.
+    struct circular_list_hook
+    {
+        circular_list_hook* next;
+        circular_list_hook* prev;
+
+        circular_list_hook() noexcept : next(nullptr),prev(nullptr) {}
+        circular_list_hook(const circular_list_hook&) noexcept : next(nullptr),prev(nullptr) {}
+        circular_list_hook& operator=(const circular_list_hook&) noexcept {return *this;}
+
+        bool is_linked() const noexcept {return next != nullptr;}
+    };
+
+    // Circular list over objects the caller owns, linked through the hook
+    // member _Hook. Nothing is allocated or copied; the caller must keep each
+    // object alive (and linked in at most one list per hook) while it is in it.
+    template<typename _Tp,circular_list_hook _Tp::*_Hook>
+      class intrusive_circular_list
+    {
+        public:
+            template <bool _Const>
+              class list_iterator
+            {
+                public:
+                    typedef std::bidirectional_iterator_tag iterator_category;
+                    typedef _Tp value_type;
+                    typedef ptrdiff_t difference_type;
+                    typedef typename std::conditional<_Const,const _Tp*,_Tp*>::type pointer;
+                    typedef typename std::conditional<_Const,const _Tp&,_Tp&>::type reference;
+
+                    list_iterator() : _node(nullptr),_offset(0) {}
+                    list_iterator(circular_list_hook* n,ptrdiff_t offset) : _node(n),_offset(offset) {}
+                    template <bool _OtherConst,typename = typename std::enable_if<_Const && !_OtherConst>::type>
+                      list_iterator(const list_iterator<_OtherConst>& other) : _node(other._node),_offset(other._offset) {}
+
+                    reference operator*() const {return *from_hook(_node,_offset);}
+                    pointer operator->() const {return from_hook(_node,_offset);}
+
+                    list_iterator& operator++()
+                    {
+                        _node = _node->next;
+                        return *this;
+                    }
+
+                    list_iterator operator++(int)
+                    {
+                        list_iterator tmp = *this;
+                        _node = _node->next;
+                        return tmp;
+                    }
+
+                    list_iterator& operator--()
+                    {
+                        _node = _node->prev;
+                        return *this;
+                    }
+
+                    list_iterator operator--(int)
+                    {
+                        list_iterator tmp = *this;
+                        _node = _node->prev;
+                        return tmp;
+                    }
+
+                    bool operator==(const list_iterator& other) const {return _node == other._node;}
+                    bool operator!=(const list_iterator& other) const {return _node != other._node;}
+                    circular_list_hook* get_node() const {return _node;}
+
+                private:
+                    circular_list_hook* _node;
+                    ptrdiff_t _offset;
+                    template <bool>
+                      friend class list_iterator;
+            };
+
+            typedef list_iterator<false> iterator;
+            typedef list_iterator<true> const_iterator;
+            typedef size_t size_type;
+            typedef _Tp value_type;
+
+        private:
+            circular_list_hook head;
+            size_type length;
+            // Distance from an object to its hook. It is measured on the objects
+            // linked in, since applying _Hook to anything but a real _Tp is
+            // undefined; it is the same for every _Tp, so later links only
+            // store the same value again.
+            ptrdiff_t hook_offset;
+
+            circular_list_hook* to_hook(_Tp& v) noexcept
+            {
+                circular_list_hook* h = &(v.*_Hook);
+                hook_offset = reinterpret_cast<char*>(h) - reinterpret_cast<char*>(std::addressof(v));
+                return h;
+            }
+
+            static _Tp* from_hook(circular_list_hook* h,ptrdiff_t offset) noexcept {return reinterpret_cast<_Tp*>(reinterpret_cast<char*>(h) - offset);}
+            _Tp* from_hook(circular_list_hook* h) const noexcept {return from_hook(h,hook_offset);}
+
+            static void link_before(circular_list_hook* pos,circular_list_hook* n) noexcept
+            {
+                n->next = pos;
+                n->prev = pos->prev;
+                pos->prev->next = n;
+                pos->prev = n;
+            }
+
+            static void unlink(circular_list_hook* n) noexcept
+            {
+                n->prev->next = n->next;
+                n->next->prev = n->prev;
+                n->next = nullptr;
+                n->prev = nullptr;
+            }
+
+            template <typename Compare>
+              circular_list_hook* merge_chains(circular_list_hook* a,circular_list_hook* b,Compare& c) const
+            {
+                circular_list_hook dummy;
+                circular_list_hook* tail = &dummy;
+                while (a && b)
+                {
+                    if (c(*from_hook(b),*from_hook(a)))
+                    {
+                        tail->next = b;
+                        b = b->next;
+                    }
+                    else
+                    {
+                        tail->next = a;
+                        a = a->next;
+                    }
+                    tail = tail->next;
+                }
+                tail->next = a ? a : b;
+                return dummy.next;
+            }
+
+            void adopt(intrusive_circular_list& other) noexcept
+            {
+                if (other.empty()) return;
+                head.next = other.head.next;
+                head.prev = other.head.prev;
+                head.next->prev = &head;
+                head.prev->next = &head;
+                length = other.length;
+                hook_offset = other.hook_offset;
+                other.head.next = &other.head;
+                other.head.prev = &other.head;
+                other.length = 0;
+            }
+
+        public:
+            intrusive_circular_list() noexcept : length(0),hook_offset(0)
+            {
+                head.next = &head;
+                head.prev = &head;
+            }
+
+            intrusive_circular_list(const intrusive_circular_list&) = delete;
+            intrusive_circular_list& operator=(const intrusive_circular_list&) = delete;
+
+            intrusive_circular_list(intrusive_circular_list&& other) noexcept : intrusive_circular_list() {adopt(other);}
+
+            intrusive_circular_list& operator=(intrusive_circular_list&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    clear();
+                    adopt(other);
+                }
+                return *this;
+            }
+
+            ~intrusive_circular_list() {clear();}
+
+            [[nodiscard]] bool empty() const noexcept {return head.next == &head;}
+            [[nodiscard]] size_type size() const noexcept {return length;}
+
+            iterator begin() noexcept {return iterator(head.next,hook_offset);}
+            iterator end() noexcept {return iterator(&head,hook_offset);}
+            iterator last() noexcept {return iterator(head.prev,hook_offset);}
+            const_iterator begin() const noexcept {return const_iterator(head.next,hook_offset);}
+            const_iterator end() const noexcept {return const_iterator(const_cast<circular_list_hook*>(&head),hook_offset);}
+            const_iterator last() const noexcept {return const_iterator(head.prev,hook_offset);}
+            const_iterator cbegin() const noexcept {return begin();}
+            const_iterator cend() const noexcept {return end();}
+            iterator iterator_to(_Tp& v) noexcept {return iterator(to_hook(v),hook_offset);}
+
+            _Tp& front()
+            {
+                if (empty()) throw std::out_of_range("List Is Empty!");
+                return *from_hook(head.next);
+            }
+
+            const _Tp& front() const
+            {
+                if (empty()) throw std::out_of_range("List Is Empty!");
+                return *from_hook(head.next);
+            }
+
+            _Tp& back()
+            {
+                if (empty()) throw std::out_of_range("List Is Empty!");
+                return *from_hook(head.prev);
+            }
+
+            const _Tp& back() const
+            {
+                if (empty()) throw std::out_of_range("List Is Empty!");
+                return *from_hook(head.prev);
+            }
+
+            iterator insert(iterator pos,_Tp& v) noexcept
+            {
+                circular_list_hook* p = pos.get_node() ? pos.get_node() : &head;
+                circular_list_hook* h = to_hook(v);
+                link_before(p,h);
+                length++;
+                return iterator(h,hook_offset);
+            }
+
+            void push_back(_Tp& v) noexcept {insert(end(),v);}
+            void push_front(_Tp& v) noexcept {insert(begin(),v);}
+
+            iterator erase(iterator pos) noexcept
+            {
+                circular_list_hook* p = pos.get_node();
+                if (!p || p == &head) return end();
+                circular_list_hook* next = p->next;
+                unlink(p);
+                length--;
+                return iterator(next,hook_offset);
+            }
+
+            // v must be in this list or not linked at all; unlinked is a no-op.
+            void erase(_Tp& v) noexcept
+            {
+                if ((v.*_Hook).is_linked()) erase(iterator_to(v));
+            }
+
+            void pop_front()
+            {
+                if (empty()) throw std::out_of_range("List Is Empty!");
+                erase(begin());
+            }
+
+            void pop_back()
+            {
+                if (empty()) throw std::out_of_range("List Is Empty!");
+                erase(last());
+            }
+
+            void clear() noexcept
+            {
+                circular_list_hook* curr = head.next;
+                while (curr != &head)
+                {
+                    circular_list_hook* next = curr->next;
+                    curr->next = nullptr;
+                    curr->prev = nullptr;
+                    curr = next;
+                }
+                head.next = &head;
+                head.prev = &head;
+                length = 0;
+            }
+
+            void splice(iterator pos,intrusive_circular_list& other) noexcept
+            {
+                if (&other == this || other.empty()) return;
+                circular_list_hook* p = pos.get_node() ? pos.get_node() : &head;
+                circular_list_hook* first = other.head.next;
+                circular_list_hook* last_node = other.head.prev;
+                first->prev = p->prev;
+                last_node->next = p;
+                p->prev->next = first;
+                p->prev = last_node;
+                length += other.length;
+                hook_offset = other.hook_offset;
+                other.head.next = &other.head;
+                other.head.prev = &other.head;
+                other.length = 0;
+            }
+
+            void reverse() noexcept
+            {
+                circular_list_hook* curr = &head;
+                do
+                {
+                    circular_list_hook* next = curr->next;
+                    curr->next = curr->prev;
+                    curr->prev = next;
+                    curr = next;
+                }
+                while (curr != &head);
+            }
+
+            void sort() {sort([](const _Tp& a,const _Tp& b) {return a < b;});}
+
+            // Stable bottom-up merge sort over the hook chain; bins[i] holds a
+            // sorted run of 2^i nodes, prev links are rebuilt once at the end.
+            template <typename Compare>
+              void sort(Compare c)
+            {
+                if (length < 2) return;
+                head.prev->next = nullptr;
+                circular_list_hook* bins[64] = {};
+                int fill = 0;
+                circular_list_hook* curr = head.next;
+                while (curr)
+                {
+                    circular_list_hook* carry = curr;
+                    curr = curr->next;
+                    carry->next = nullptr;
+                    int i = 0;
+                    for (;i < fill && bins[i];i++)
+                    {
+                        carry = merge_chains(bins[i],carry,c);
+                        bins[i] = nullptr;
+                    }
+                    bins[i] = carry;
+                    if (i == fill) fill++;
+                }
+                circular_list_hook* sorted = nullptr;
+                for (int i = 0;i < fill;i++) if (bins[i]) sorted = sorted ? merge_chains(bins[i],sorted,c) : bins[i];
+                circular_list_hook* prev = &head;
+                head.next = sorted;
+                for (circular_list_hook* n = sorted;n;n = n->next)
+                {
+                    n->prev = prev;
+                    prev = n;
+                }
+                prev->next = &head;
+                head.prev = prev;
+            }
+    };
+_GLIBCXX_END_NAMESPACE_CONTAINER
+}
+#endif
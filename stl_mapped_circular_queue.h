@@ -0,0 +1,223 @@
+#ifndef _STL_MAPPED_CIRCULAR_QUEUE_H_
+#define _STL_MAPPED_CIRCULAR_QUEUE_H_ 1
+
+#include <circular_queue>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace std
+{
+	// circular_queue whose header and slots live in a MAP_SHARED file mapping.
+	// Each slot is written before the tail that publishes it (and read before
+	// the head that releases it), so a process killed at any point leaves a
+	// queue that reopens with every completed enqueue intact. flush() makes the
+	// current state durable against machine crashes as well.
+	template <typename _Tp>
+	  class mapped_circular_queue
+	{
+			static_assert(std::is_trivially_copyable<_Tp>::value,"mapped_circular_queue requires a trivially copyable type");
+			static_assert(std::atomic<uint64_t>::is_always_lock_free,"mapped_circular_queue requires lock-free 64-bit atomics");
+
+		private:
+			static const uint64_t file_magic = 0x51524943524c4351ULL;
+			static const uint32_t file_version = 1;
+
+			struct header
+			{
+				uint64_t magic;
+				uint32_t version;
+				uint32_t elem_size;
+				uint64_t capacity;
+				alignas(64) std::atomic<uint64_t> head;
+				alignas(64) std::atomic<uint64_t> tail;
+			};
+
+			static size_t data_offset()
+			{
+				size_t align = alignof(_Tp) > alignof(header) ? alignof(_Tp) : alignof(header);
+				return (sizeof(header) + align - 1) / align * align;
+			}
+
+			int fd;
+			void* base;
+			size_t mapped_bytes;
+			header* hdr;
+			_Tp* slots;
+			size_t capacity;
+
+			static void fail(const char* what) {throw std::system_error(errno,std::generic_category(),what);}
+
+			void unmap() noexcept
+			{
+				if (base) ::munmap(base,mapped_bytes);
+				if (fd >= 0) ::close(fd);
+				base = nullptr;
+				fd = -1;
+			}
+
+			void open_file(const char* path,size_t cap)
+			{
+				fd = ::open(path,O_RDWR | O_CREAT | O_CLOEXEC,0644);
+				if (fd < 0) fail("open");
+				struct stat st;
+				if (::fstat(fd,&st) != 0) fail("fstat");
+				bool fresh = st.st_size == 0;
+				if (!fresh && static_cast<size_t>(st.st_size) < sizeof(header)) throw std::runtime_error("Queue file is truncated");
+				if (fresh)
+				{
+					if (cap == 0) throw std::invalid_argument("Capacity must be at least 1");
+					mapped_bytes = data_offset() + cap * sizeof(_Tp);
+					if (::ftruncate(fd,static_cast<off_t>(mapped_bytes)) != 0) fail("ftruncate");
+				}
+				else mapped_bytes = static_cast<size_t>(st.st_size);
+				base = ::mmap(nullptr,mapped_bytes,PROT_READ | PROT_WRITE,MAP_SHARED,fd,0);
+				if (base == MAP_FAILED)
+				{
+					base = nullptr;
+					fail("mmap");
+				}
+				hdr = static_cast<header*>(base);
+				slots = reinterpret_cast<_Tp*>(static_cast<char*>(base) + data_offset());
+				if (fresh || hdr->magic == 0) initialise(cap);
+				else recover(cap);
+			}
+
+			void initialise(size_t cap)
+			{
+				if (cap == 0) throw std::invalid_argument("Capacity must be at least 1");
+				if (mapped_bytes < data_offset() + cap * sizeof(_Tp)) throw std::runtime_error("Queue file is truncated");
+				hdr->version = file_version;
+				hdr->elem_size = sizeof(_Tp);
+				hdr->capacity = cap;
+				hdr->head.store(0,std::memory_order_relaxed);
+				hdr->tail.store(0,std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_release);
+				hdr->magic = file_magic;
+				capacity = cap;
+				flush();
+			}
+
+			void recover(size_t cap)
+			{
+				if (hdr->magic != file_magic || hdr->version != file_version) throw std::runtime_error("Not a circular queue file");
+				if (hdr->elem_size != sizeof(_Tp)) throw std::runtime_error("Queue file element size mismatch");
+				if (cap != 0 && hdr->capacity != cap) throw std::invalid_argument("Capacity does not match existing queue file");
+				if (mapped_bytes < data_offset() + hdr->capacity * sizeof(_Tp)) throw std::runtime_error("Queue file is truncated");
+				uint64_t h = hdr->head.load(std::memory_order_acquire);
+				uint64_t t = hdr->tail.load(std::memory_order_acquire);
+				if (t - h > hdr->capacity) throw std::runtime_error("Queue file is corrupt");
+				capacity = hdr->capacity;
+			}
+
+		public:
+			typedef size_t size_type;
+			typedef _Tp* pointer;
+			typedef _Tp& reference;
+			typedef _Tp value_type;
+
+			// Opens path, creating a queue of cap slots if the file is new or empty.
+			// An existing file is recovered as is; cap == 0 accepts its capacity.
+			explicit mapped_circular_queue(const std::string& path,size_type cap = 0) : fd(-1),base(nullptr),mapped_bytes(0),hdr(nullptr),slots(nullptr),capacity(0)
+			{
+				try
+				{
+					open_file(path.c_str(),cap);
+				}
+				catch (...)
+				{
+					unmap();
+					throw;
+				}
+			}
+
+			mapped_circular_queue(const mapped_circular_queue&) = delete;
+			mapped_circular_queue& operator=(const mapped_circular_queue&) = delete;
+
+			mapped_circular_queue(mapped_circular_queue&& other) noexcept : fd(other.fd),base(other.base),mapped_bytes(other.mapped_bytes),hdr(other.hdr),slots(other.slots),capacity(other.capacity)
+			{
+				other.fd = -1;
+				other.base = nullptr;
+				other.hdr = nullptr;
+				other.capacity = 0;
+			}
+
+			mapped_circular_queue& operator=(mapped_circular_queue&& other) noexcept
+			{
+				if (this != &other)
+				{
+					unmap();
+					fd = other.fd;
+					base = other.base;
+					mapped_bytes = other.mapped_bytes;
+					hdr = other.hdr;
+					slots = other.slots;
+					capacity = other.capacity;
+					other.fd = -1;
+					other.base = nullptr;
+					other.hdr = nullptr;
+					other.capacity = 0;
+				}
+				return *this;
+			}
+
+			~mapped_circular_queue() {unmap();}
+
+			bool enqueue(const value_type& value)
+			{
+				if (is_full()) return false;
+				uint64_t t = hdr->tail.load(std::memory_order_relaxed);
+				std::memcpy(static_cast<void*>(slots + t % capacity),&value,sizeof(_Tp));
+				hdr->tail.store(t + 1,std::memory_order_release);
+				return true;
+			}
+
+			bool dequeue()
+			{
+				if (isEmpty()) return false;
+				hdr->head.store(hdr->head.load(std::memory_order_relaxed) + 1,std::memory_order_release);
+				return true;
+			}
+
+			bool dequeue(value_type& out)
+			{
+				if (isEmpty()) return false;
+				uint64_t h = hdr->head.load(std::memory_order_relaxed);
+				std::memcpy(static_cast<void*>(&out),slots + h % capacity,sizeof(_Tp));
+				hdr->head.store(h + 1,std::memory_order_release);
+				return true;
+			}
+
+			value_type front() const
+			{
+				if (isEmpty()) throw std::runtime_error("Queue is empty");
+				return slots[hdr->head.load(std::memory_order_relaxed) % capacity];
+			}
+
+			value_type rear() const
+			{
+				if (isEmpty()) throw std::runtime_error("Queue is empty");
+				return slots[(hdr->tail.load(std::memory_order_relaxed) - 1) % capacity];
+			}
+
+			bool isEmpty() const {return size() == 0;}
+			bool is_full() const {return size() == capacity;}
+			size_type size() const {return hdr ? hdr->tail.load(std::memory_order_acquire) - hdr->head.load(std::memory_order_acquire) : 0;}
+			size_type getcapacity() const {return capacity;}
+
+			// Blocks until the mapping (header and slots) has reached the file.
+			void flush()
+			{
+				if (base && ::msync(base,mapped_bytes,MS_SYNC) != 0) fail("msync");
+			}
+	};
+}
+#endif
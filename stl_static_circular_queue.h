@@ -0,0 +1,203 @@
+#ifndef _STL_STATIC_CIRCULAR_QUEUE_H_
+#define _STL_STATIC_CIRCULAR_QUEUE_H_ 1
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace std
+{
+	// Index wrap for a ring of _Nm slots; i is always below 2 * _Nm, so a
+	// non power-of-two size needs a compare-and-subtract rather than a modulo.
+	template <size_t _Nm>
+	  constexpr size_t __static_ring_wrap(size_t i) noexcept {return (_Nm & (_Nm - 1)) == 0 ? i & (_Nm - 1) : (i >= _Nm ? i - _Nm : i);}
+
+	// Slot storage for static_circular_queue. Trivial types keep a plain array
+	// so the whole queue stays a literal type usable in constant expressions;
+	// everything else gets raw aligned bytes with explicit construct/destroy.
+	template <typename _Tp,size_t _Nm,bool = std::is_trivial<_Tp>::value>
+	  struct __static_ring_storage
+	{
+		_Tp slots[_Nm];
+		size_t head;
+		size_t count;
+
+		constexpr __static_ring_storage() noexcept : slots(),head(0),count(0) {}
+
+		constexpr _Tp& slot(size_t i) noexcept {return slots[i];}
+		constexpr const _Tp& slot(size_t i) const noexcept {return slots[i];}
+
+		template <typename... Args>
+		  constexpr void construct(size_t i,Args&&... args) {slots[i] = _Tp(std::forward<Args>(args)...);}
+
+		constexpr void destroy(size_t) noexcept {}
+	};
+
+	template <typename _Tp,size_t _Nm>
+	  struct __static_ring_storage<_Tp,_Nm,false>
+	{
+		alignas(_Tp) unsigned char raw[_Nm * sizeof(_Tp)];
+		size_t head;
+		size_t count;
+
+		__static_ring_storage() noexcept : head(0),count(0) {}
+
+		__static_ring_storage(const __static_ring_storage& other) : head(0),count(0) {copy_from(other);}
+		__static_ring_storage(__static_ring_storage&& other) noexcept(std::is_nothrow_move_constructible<_Tp>::value) : head(0),count(0) {move_from(other);}
+
+		__static_ring_storage& operator=(const __static_ring_storage& other)
+		{
+			if (this != &other)
+			{
+				clear();
+				copy_from(other);
+			}
+			return *this;
+		}
+
+		__static_ring_storage& operator=(__static_ring_storage&& other) noexcept(std::is_nothrow_move_constructible<_Tp>::value)
+		{
+			if (this != &other)
+			{
+				clear();
+				move_from(other);
+			}
+			return *this;
+		}
+
+		~__static_ring_storage() {clear();}
+
+		_Tp& slot(size_t i) noexcept {return *std::launder(reinterpret_cast<_Tp*>(raw + i * sizeof(_Tp)));}
+		const _Tp& slot(size_t i) const noexcept {return *std::launder(reinterpret_cast<const _Tp*>(raw + i * sizeof(_Tp)));}
+
+		template <typename... Args>
+		  void construct(size_t i,Args&&... args) {::new (static_cast<void*>(raw + i * sizeof(_Tp))) _Tp(std::forward<Args>(args)...);}
+
+		void destroy(size_t i) noexcept {slot(i).~_Tp();}
+
+		static constexpr size_t wrap(size_t i) noexcept {return __static_ring_wrap<_Nm>(i);}
+
+		// Rebuilds an empty ring from other starting at slot 0; on a throw the
+		// elements made so far are destroyed and the ring is left empty.
+		void copy_from(const __static_ring_storage& other)
+		{
+			try
+			{
+				for (;count < other.count;count++) construct(count,other.slot(wrap(other.head + count)));
+			}
+			catch (...)
+			{
+				clear();
+				throw;
+			}
+		}
+
+		void move_from(__static_ring_storage& other)
+		{
+			try
+			{
+				for (;count < other.count;count++) construct(count,std::move(other.slot(wrap(other.head + count))));
+			}
+			catch (...)
+			{
+				clear();
+				throw;
+			}
+			other.clear();
+		}
+
+		void clear() noexcept
+		{
+			for (;count > 0;count--)
+			{
+				destroy(head);
+				head = wrap(head + 1);
+			}
+			head = 0;
+		}
+	};
+
+	// circular_queue with a compile-time capacity and the slots stored inline:
+	// no allocation, no pointer to chase, sizeof is _Nm elements plus two words.
+	// Whether indices wrap with a mask is decided at compile time from _Nm.
+	template <typename _Tp,size_t _Nm>
+	  class static_circular_queue : private __static_ring_storage<_Tp,_Nm>
+	{
+			static_assert(_Nm > 0,"static_circular_queue capacity must be at least 1");
+
+		private:
+			typedef __static_ring_storage<_Tp,_Nm> storage;
+
+			static constexpr size_t wrap(size_t i) noexcept {return __static_ring_wrap<_Nm>(i);}
+
+		public:
+			typedef size_t size_type;
+			typedef _Tp value_type;
+			typedef _Tp& reference;
+			typedef const _Tp& const_reference;
+
+			constexpr static_circular_queue() noexcept {}
+
+			template <typename... Args>
+			  constexpr bool emplace(Args&&... args)
+			{
+				if (is_full()) return false;
+				storage::construct(wrap(this->head + this->count),std::forward<Args>(args)...);
+				this->count++;
+				return true;
+			}
+
+			constexpr bool enqueue(const value_type& value) {return emplace(value);}
+			constexpr bool enqueue(value_type&& value) {return emplace(std::move(value));}
+
+			constexpr bool dequeue()
+			{
+				if (isEmpty()) return false;
+				storage::destroy(this->head);
+				this->head = wrap(this->head + 1);
+				this->count--;
+				return true;
+			}
+
+			constexpr bool dequeue(value_type& out)
+			{
+				if (isEmpty()) return false;
+				out = std::move(storage::slot(this->head));
+				return dequeue();
+			}
+
+			template <typename OutputIt>
+			  constexpr size_type dequeue_n(OutputIt out,size_type n)
+			{
+				size_type count = n < this->count ? n : this->count;
+				for (size_type i = 0;i < count;i++,++out)
+				{
+					*out = std::move(storage::slot(this->head));
+					dequeue();
+				}
+				return count;
+			}
+
+			constexpr value_type front() const
+			{
+				if (isEmpty()) throw std::runtime_error("Queue is empty");
+				return storage::slot(this->head);
+			}
+
+			constexpr value_type rear() const
+			{
+				if (isEmpty()) throw std::runtime_error("Queue is empty");
+				return storage::slot(wrap(this->head + this->count - 1));
+			}
+
+			constexpr void clear() noexcept {while (dequeue()) {}}
+
+			constexpr bool isEmpty() const noexcept {return this->count == 0;}
+			constexpr bool is_full() const noexcept {return this->count == _Nm;}
+			constexpr size_type size() const noexcept {return this->count;}
+			static constexpr size_type getcapacity() noexcept {return _Nm;}
+	};
+}
+#endif
@@ -0,0 +1,211 @@
+#ifndef _STL_TIMING_WHEEL_H_
+#define _STL_TIMING_WHEEL_H_ 1
+
+#include <circular_list>
+#include <cstdint>
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_CONTAINER
+    // Base for objects scheduled on a timing_wheel; derive from it and keep the
+    // object alive while it is pending, which includes the destruction of the
+    // wheel it is pending on. Expiry is in caller-defined ticks.
+    struct timing_wheel_timer
+    {
+        circular_list_hook hook;
+        uint64_t expires;
+        unsigned char level;
+        unsigned char slot;
+
+        static const unsigned char idle = 0xff;
+
+        timing_wheel_timer() noexcept : expires(0),level(idle),slot(0) {}
+        timing_wheel_timer(const timing_wheel_timer& other) noexcept : hook(),expires(other.expires),level(idle),slot(0) {}
+        timing_wheel_timer& operator=(const timing_wheel_timer& other) noexcept
+        {
+            expires = other.expires;
+            return *this;
+        }
+
+        bool pending() const noexcept {return level != idle;}
+    };
+
+    // Hierarchical hashed timing wheel: levels of 64 slots, each slot an
+    // intrusive_circular_list, so schedule and cancel are O(1) with no allocation.
+    // Level l covers deltas below 64^(l+1) ticks; when the lower level wraps, the
+    // matching slot of the next level is cascaded down. Deadlines beyond the last
+    // level park in its farthest slot and are re-filed when it cascades.
+    class timing_wheel
+    {
+        public:
+            typedef intrusive_circular_list<timing_wheel_timer,&timing_wheel_timer::hook> timer_list;
+            typedef size_t size_type;
+
+            static const unsigned slot_bits = 6;
+            static const unsigned slots = 1u << slot_bits;
+            static const unsigned levels = 5;
+
+        private:
+            // Level of a timer taken off the wheel for the tick being fired.
+            static const unsigned char firing_level = levels;
+
+            timer_list wheel[levels][slots];
+            timer_list firing;
+            uint64_t occupied[levels];
+            uint64_t current;
+            size_type count;
+
+            static_assert(slots == 64,"occupied holds one bit per slot");
+
+            static uint64_t span(unsigned level) noexcept {return uint64_t(1) << (slot_bits * (level + 1));}
+
+            // Files t relative to base, the next tick that has not been expired yet.
+            void place(timing_wheel_timer& t,uint64_t base) noexcept
+            {
+                uint64_t e = t.expires < base ? base : t.expires;
+                unsigned level = 0;
+                while (level + 1 < levels && e - base >= span(level)) level++;
+                if (e - base >= span(level)) e = base + span(level) - 1;
+                unsigned slot = static_cast<unsigned>(e >> (slot_bits * level)) & (slots - 1);
+                t.level = static_cast<unsigned char>(level);
+                t.slot = static_cast<unsigned char>(slot);
+                wheel[level][slot].push_back(t);
+                occupied[level] |= uint64_t(1) << slot;
+            }
+
+            static unsigned first_set(uint64_t bits) noexcept {return static_cast<unsigned>(__builtin_ctzll(bits));}
+
+            // Earliest tick after current that expires or cascades a non-empty
+            // slot; every tick before it would do nothing and can be skipped.
+            uint64_t next_event() const noexcept
+            {
+                uint64_t best = ~uint64_t(0);
+                for (unsigned level = 0;level < levels;level++)
+                {
+                    if (!occupied[level]) continue;
+                    unsigned shift = slot_bits * level;
+                    uint64_t k = (current >> shift) + 1;
+                    unsigned from = static_cast<unsigned>(k) & (slots - 1);
+                    uint64_t bits = from ? (occupied[level] >> from) | (occupied[level] << (slots - from)) : occupied[level];
+                    uint64_t tick = (k + first_set(bits)) << shift;
+                    if (tick < best) best = tick;
+                }
+                return best;
+            }
+
+            void cascade(unsigned level,unsigned slot,uint64_t base) noexcept
+            {
+                timer_list moving(std::move(wheel[level][slot]));
+                occupied[level] &= ~(uint64_t(1) << slot);
+                while (!moving.empty())
+                {
+                    timing_wheel_timer& t = moving.front();
+                    moving.pop_front();
+                    place(t,base);
+                }
+            }
+
+            template <typename _Fire>
+              void fire_due(_Fire& fire,size_type& fired)
+            {
+                while (!firing.empty())
+                {
+                    timing_wheel_timer& timer = firing.front();
+                    firing.pop_front();
+                    timer.level = timing_wheel_timer::idle;
+                    count--;
+                    fired++;
+                    fire(timer);
+                }
+            }
+
+        public:
+            explicit timing_wheel(uint64_t now = 0) noexcept : occupied(),current(now),count(0) {}
+
+            timing_wheel(const timing_wheel&) = delete;
+            timing_wheel& operator=(const timing_wheel&) = delete;
+
+            // Timers still pending are left idle and unlinked, free to be
+            // scheduled on another wheel.
+            ~timing_wheel()
+            {
+                for (unsigned level = 0;level < levels;level++)
+                    for (unsigned slot = 0;slot < slots;slot++)
+                        for (timing_wheel_timer& t : wheel[level][slot]) t.level = timing_wheel_timer::idle;
+                for (timing_wheel_timer& t : firing) t.level = timing_wheel_timer::idle;
+            }
+
+            // (Re)arms t to fire at tick expires; deadlines not after now() fire
+            // on the next advance.
+            void schedule(timing_wheel_timer& t,uint64_t expires) noexcept
+            {
+                cancel(t);
+                t.expires = expires;
+                place(t,current + 1);
+                count++;
+            }
+
+            bool cancel(timing_wheel_timer& t) noexcept
+            {
+                if (!t.pending()) return false;
+                if (t.level == firing_level) firing.erase(t);
+                else
+                {
+                    timer_list& slot = wheel[t.level][t.slot];
+                    slot.erase(t);
+                    if (slot.empty()) occupied[t.level] &= ~(uint64_t(1) << t.slot);
+                }
+                t.level = timing_wheel_timer::idle;
+                count--;
+                return true;
+            }
+
+            // Moves the clock to now, calling fire(timer) for every timer that
+            // expires on the way, in tick order. Each timer is unlinked and idle
+            // before its call, so fire may re-arm or destroy it and may cancel or
+            // re-arm any other timer, including one due in the same tick that has
+            // not fired yet; a timer re-armed for a tick not after now() fires on
+            // the following tick, within this call if that is still due. Idle
+            // stretches are jumped over, so the cost follows the number of
+            // occupied slots passed rather than the ticks elapsed. Returns the
+            // number of timers fired. If fire throws, the rest of that tick's
+            // timers stay pending and fire first on the next call.
+            template <typename _Fire>
+              size_type advance(uint64_t now,_Fire fire)
+            {
+                size_type fired = 0;
+                fire_due(fire,fired);
+                while (current < now)
+                {
+                    uint64_t t = next_event();
+                    if (t > now)
+                    {
+                        current = now;
+                        break;
+                    }
+                    current = t;
+                    unsigned index = static_cast<unsigned>(t) & (slots - 1);
+                    for (unsigned level = 1;index == 0 && level < levels;level++)
+                    {
+                        index = static_cast<unsigned>(t >> (slot_bits * level)) & (slots - 1);
+                        cascade(level,index,t);
+                    }
+                    // Moved out before any fire() call: a timer re-armed for t + 64
+                    // hashes back into this slot.
+                    index = static_cast<unsigned>(t) & (slots - 1);
+                    timer_list& due = wheel[0][index];
+                    for (timing_wheel_timer& timer : due) timer.level = firing_level;
+                    firing.splice(firing.end(),due);
+                    occupied[0] &= ~(uint64_t(1) << index);
+                    fire_due(fire,fired);
+                }
+                return fired;
+            }
+
+            uint64_t now() const noexcept {return current;}
+            size_type size() const noexcept {return count;}
+            bool empty() const noexcept {return count == 0;}
+    };
+_GLIBCXX_END_NAMESPACE_CONTAINER
+}
+#endif
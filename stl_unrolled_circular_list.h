@@ -0,0 +1,755 @@
+#ifndef _STL_UNROLLED_CIRCULAR_LIST_H_
+#define _STL_UNROLLED_CIRCULAR_LIST_H_ 1
+
+#include <cstddef>
+#include <stdexcept>
+#include <iterator>
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <initializer_list>
+#include <vector>
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_CONTAINER
+    template<typename _Tp>
+      constexpr size_t __unrolled_default_chunk() {return sizeof(_Tp) * 8 > 256 ? 8 : 256 / sizeof(_Tp);}
+
+    // Circular list that stores up to _ChunkSize elements per node, so walks
+    // chase one pointer per chunk and operator[] skips whole chunks.
+    //
+    // Iterator stability: insert may split the target chunk and invalidates
+    // iterators into it; erase invalidates iterators into the affected chunk
+    // and its successor (which may be merged in). Iterators into any other
+    // chunk stay valid. sort invalidates every iterator. Unlike
+    // circular_list::iterator, ++ stops at end().
+    //
+    // Not carried over from circular_list yet: splice, split, merge, rotate,
+    // partial_sort/nth_element and the erase-safe cursor. All of them rely on
+    // relinking single nodes, which here would mean splitting chunks.
+    template<typename _Tp,size_t _ChunkSize = __unrolled_default_chunk<_Tp>(),typename _Alloc = std::allocator<_Tp> >
+      class unrolled_circular_list
+    {
+            static_assert(_ChunkSize >= 2,"chunk must hold at least two elements");
+
+        private:
+            struct chunk_base
+            {
+                chunk_base* next;
+                chunk_base* prev;
+            };
+
+            struct chunk : chunk_base
+            {
+                size_t count;
+                alignas(_Tp) unsigned char storage[sizeof(_Tp) * _ChunkSize];
+
+                chunk() : chunk_base{nullptr,nullptr},count(0) {}
+                _Tp* data() {return reinterpret_cast<_Tp*>(storage);}
+                const _Tp* data() const {return reinterpret_cast<const _Tp*>(storage);}
+            };
+
+            static chunk* as_chunk(chunk_base* b) {return static_cast<chunk*>(b);}
+            static const chunk* as_chunk(const chunk_base* b) {return static_cast<const chunk*>(b);}
+
+        public:
+            typedef size_t size_type;
+            typedef _Tp value_type;
+            typedef _Alloc allocator_type;
+
+            template <bool _Const>
+              class chunk_iterator
+            {
+                public:
+                    typedef std::bidirectional_iterator_tag iterator_category;
+                    typedef _Tp value_type;
+                    typedef ptrdiff_t difference_type;
+                    typedef typename std::conditional<_Const,const _Tp*,_Tp*>::type pointer;
+                    typedef typename std::conditional<_Const,const _Tp&,_Tp&>::type reference;
+
+                    chunk_iterator() : _chunk(nullptr),_index(0),_head(nullptr) {}
+                    chunk_iterator(chunk_base* c,size_type i,const chunk_base* h) : _chunk(c),_index(i),_head(h) {}
+                    template <bool _OtherConst,typename = typename std::enable_if<_Const && !_OtherConst>::type>
+                      chunk_iterator(const chunk_iterator<_OtherConst>& other) : _chunk(other._chunk),_index(other._index),_head(other._head) {}
+
+                    reference operator*() const {return as_chunk(_chunk)->data()[_index];}
+                    pointer operator->() const {return as_chunk(_chunk)->data() + _index;}
+
+                    chunk_iterator& operator++()
+                    {
+                        if (++_index == as_chunk(_chunk)->count)
+                        {
+                            _chunk = _chunk->next;
+                            _index = 0;
+                        }
+                        return *this;
+                    }
+
+                    chunk_iterator operator++(int)
+                    {
+                        chunk_iterator tmp = *this;
+                        ++(*this);
+                        return tmp;
+                    }
+
+                    chunk_iterator& operator--()
+                    {
+                        if (_chunk == _head || _index == 0)
+                        {
+                            _chunk = _chunk->prev;
+                            _index = as_chunk(_chunk)->count - 1;
+                        }
+                        else _index--;
+                        return *this;
+                    }
+
+                    chunk_iterator operator--(int)
+                    {
+                        chunk_iterator tmp = *this;
+                        --(*this);
+                        return tmp;
+                    }
+
+                    bool operator==(const chunk_iterator& other) const {return _chunk == other._chunk && _index == other._index;}
+                    bool operator!=(const chunk_iterator& other) const {return !(*this == other);}
+
+                private:
+                    chunk_base* _chunk;
+                    size_type _index;
+                    const chunk_base* _head;
+                    template <bool>
+                      friend class chunk_iterator;
+                    friend class unrolled_circular_list;
+            };
+
+            typedef chunk_iterator<false> iterator;
+            typedef chunk_iterator<true> const_iterator;
+
+        private:
+            typedef typename std::allocator_traits<_Alloc>::template rebind_alloc<chunk> chunk_allocator;
+            typedef std::allocator_traits<chunk_allocator> chunk_traits;
+
+            chunk_allocator alloc;
+            chunk_base head;
+            size_type length;
+
+            chunk* make_chunk()
+            {
+                chunk* c = chunk_traits::allocate(alloc,1);
+                ::new (static_cast<void*>(c)) chunk();
+                return c;
+            }
+
+            void free_chunk(chunk* c) noexcept
+            {
+                std::destroy(c->data(),c->data() + c->count);
+                c->~chunk();
+                chunk_traits::deallocate(alloc,c,1);
+            }
+
+            chunk* create_chunk_after(chunk_base* pos)
+            {
+                chunk* c = make_chunk();
+                c->prev = pos;
+                c->next = pos->next;
+                pos->next->prev = c;
+                pos->next = c;
+                return c;
+            }
+
+            void destroy_chunk(chunk* c)
+            {
+                c->prev->next = c->next;
+                c->next->prev = c->prev;
+                free_chunk(c);
+            }
+
+            // Makes room at index i of c, splitting c if it is full.
+            // Returns the chunk and index where the new element must go.
+            std::pair<chunk*,size_type> open_slot(chunk* c,size_type i)
+            {
+                if (c->count == _ChunkSize)
+                {
+                    chunk* n = create_chunk_after(c);
+                    size_type half = _ChunkSize / 2;
+                    std::uninitialized_move(c->data() + half,c->data() + _ChunkSize,n->data());
+                    std::destroy(c->data() + half,c->data() + _ChunkSize);
+                    n->count = _ChunkSize - half;
+                    c->count = half;
+                    if (i > half)
+                    {
+                        c = n;
+                        i -= half;
+                    }
+                }
+                _Tp* d = c->data();
+                if (i < c->count)
+                {
+                    ::new (static_cast<void*>(d + c->count)) _Tp(std::move(d[c->count - 1]));
+                    std::move_backward(d + i,d + c->count - 1,d + c->count);
+                    d[i].~_Tp();
+                }
+                return std::make_pair(c,i);
+            }
+
+            template <typename... Args>
+              iterator emplace_at(chunk_base* b,size_type i,Args&&... args)
+            {
+                chunk* c;
+                if (b == &head)
+                {
+                    c = head.prev != &head && as_chunk(head.prev)->count < _ChunkSize ? as_chunk(head.prev) : create_chunk_after(head.prev);
+                    i = c->count;
+                }
+                else c = as_chunk(b);
+                if (i == c->count && c->count < _ChunkSize)
+                {
+                    try
+                    {
+                        ::new (static_cast<void*>(c->data() + i)) _Tp(std::forward<Args>(args)...);
+                    }
+                    catch (...)
+                    {
+                        if (c->count == 0) destroy_chunk(c);
+                        throw;
+                    }
+                    c->count++;
+                    length++;
+                    return iterator(c,i,&head);
+                }
+                _Tp tmp(std::forward<Args>(args)...);
+                std::pair<chunk*,size_type> slot = open_slot(c,i);
+                ::new (static_cast<void*>(slot.first->data() + slot.second)) _Tp(std::move(tmp));
+                slot.first->count++;
+                length++;
+                return iterator(slot.first,slot.second,&head);
+            }
+
+            void compact(chunk* c,size_type w)
+            {
+                std::destroy(c->data() + w,c->data() + c->count);
+                length -= c->count - w;
+                c->count = w;
+            }
+
+            void reset_head()
+            {
+                head.next = &head;
+                head.prev = &head;
+                length = 0;
+            }
+
+            void steal(unrolled_circular_list& other)
+            {
+                if (other.head.next == &other.head) reset_head();
+                else
+                {
+                    head.next = other.head.next;
+                    head.prev = other.head.prev;
+                    head.next->prev = &head;
+                    head.prev->next = &head;
+                    length = other.length;
+                }
+                other.reset_head();
+            }
+
+            // Chunks taken off the ring by sort, chained through next and null
+            // terminated; prev is rebuilt when they go back on the ring.
+            struct chunk_run
+            {
+                chunk_base* first;
+                chunk_base* last;
+            };
+
+            static void run_append(chunk_run& r,chunk_base* first,chunk_base* last) noexcept
+            {
+                if (!first) return;
+                if (r.last) r.last->next = first;
+                else r.first = first;
+                r.last = last;
+                last->next = nullptr;
+            }
+
+            void ring_append(chunk_base* first) noexcept
+            {
+                while (first)
+                {
+                    chunk_base* next = first->next;
+                    first->prev = head.prev;
+                    first->next = &head;
+                    head.prev->next = first;
+                    head.prev = first;
+                    first = next;
+                }
+            }
+
+            // Drops the destroyed slots [0, used) of c by sliding the rest down.
+            static void shift_down(chunk* c,size_type used) noexcept
+            {
+                if (!used) return;
+                _Tp* d = c->data();
+                for (size_type j = used;j < c->count;j++)
+                {
+                    ::new (static_cast<void*>(d + j - used)) _Tp(std::move(d[j]));
+                    d[j].~_Tp();
+                }
+                c->count -= used;
+            }
+
+            // Binary insertion sort within one chunk. Unlike std::stable_sort it
+            // holds no element outside the chunk, so a throwing comp cannot lose one.
+            template <typename Comp>
+              static void insertion_sort(chunk* c,Comp& comp)
+            {
+                _Tp* d = c->data();
+                for (size_type i = 1;i < c->count;i++)
+                {
+                    _Tp* at = std::upper_bound(d,d + i,d[i],comp);
+                    if (at != d + i) std::rotate(at,d + i,d + i + 1);
+                }
+            }
+
+            // Stable merge of run a (earlier elements) with run b into full
+            // chunks. Output chunks come from spare, which must hold two; every
+            // input chunk emptied on the way is returned to it, so the merge
+            // never allocates. Only comp can throw; if it does, a is left with
+            // every element and b is empty.
+            template <typename Comp>
+              chunk_run merge_runs(chunk_run& a,chunk_run& b,Comp& comp,chunk_base*& spare)
+            {
+                chunk_run out = {nullptr,nullptr};
+                chunk* o = nullptr;
+                chunk* src[2] = {as_chunk(a.first),as_chunk(b.first)};
+                chunk_base* last[2] = {a.last,b.last};
+                size_type pos[2] = {0,0};
+                try
+                {
+                    while (src[0] && src[1])
+                    {
+                        int k = comp(src[1]->data()[pos[1]],src[0]->data()[pos[0]]) ? 1 : 0;
+                        if (!o || o->count == _ChunkSize)
+                        {
+                            o = as_chunk(spare);
+                            spare = spare->next;
+                            run_append(out,o,o);
+                        }
+                        _Tp& v = src[k]->data()[pos[k]];
+                        ::new (static_cast<void*>(o->data() + o->count)) _Tp(std::move(v));
+                        v.~_Tp();
+                        o->count++;
+                        if (++pos[k] == src[k]->count)
+                        {
+                            chunk* done = src[k];
+                            src[k] = as_chunk(done->next);
+                            pos[k] = 0;
+                            done->count = 0;
+                            done->next = spare;
+                            spare = done;
+                        }
+                    }
+                }
+                catch (...)
+                {
+                    for (int k = 0;k < 2;k++)
+                    {
+                        if (!src[k]) continue;
+                        shift_down(src[k],pos[k]);
+                        run_append(out,src[k],last[k]);
+                    }
+                    a = out;
+                    b.first = b.last = nullptr;
+                    throw;
+                }
+                int k = src[0] ? 0 : 1;
+                if (src[k])
+                {
+                    shift_down(src[k],pos[k]);
+                    run_append(out,src[k],last[k]);
+                }
+                return out;
+            }
+
+            // Fallback for types whose move may throw: sorts each chunk, then
+            // merges runs of chunks through the iterators with inplace_merge.
+            template <typename Comp>
+              void sort_in_place(Comp& comp)
+            {
+                for (chunk_base* b = head.next;b != &head;b = b->next) std::stable_sort(as_chunk(b)->data(),as_chunk(b)->data() + as_chunk(b)->count,comp);
+                for (size_type width = 1;;width *= 2)
+                {
+                    bool merged = false;
+                    chunk_base* first = head.next;
+                    while (first != &head)
+                    {
+                        chunk_base* mid = first;
+                        for (size_type i = 0;i < width && mid != &head;i++) mid = mid->next;
+                        if (mid == &head) break;
+                        chunk_base* stop = mid;
+                        for (size_type i = 0;i < width && stop != &head;i++) stop = stop->next;
+                        std::inplace_merge(iterator(first,0,&head),iterator(mid,0,&head),iterator(stop,0,&head),comp);
+                        merged = true;
+                        first = stop;
+                    }
+                    if (!merged) break;
+                }
+            }
+
+            void copy_alloc(const chunk_allocator& a,std::true_type) {alloc = a;}
+            void copy_alloc(const chunk_allocator&,std::false_type) {}
+            // A moved-from list keeps allocating chunks, so it keeps a copy.
+            void move_alloc(chunk_allocator& a,std::true_type) {alloc = a;}
+            void move_alloc(chunk_allocator&,std::false_type) {}
+
+        public:
+            unrolled_circular_list() : unrolled_circular_list(allocator_type()) {}
+            explicit unrolled_circular_list(const allocator_type& a) : alloc(a) {reset_head();}
+
+            template <typename InputIt,typename = std::_RequireInputIter<InputIt> >
+              unrolled_circular_list(InputIt first,InputIt last,const allocator_type& a = allocator_type()) : unrolled_circular_list(a)
+            {
+                for (;first != last;++first) push_back(*first);
+            }
+
+            unrolled_circular_list(std::initializer_list<value_type> init,const allocator_type& a = allocator_type()) : unrolled_circular_list(init.begin(),init.end(),a) {}
+
+            unrolled_circular_list(const unrolled_circular_list& other) : unrolled_circular_list(other.begin(),other.end(),std::allocator_traits<_Alloc>::select_on_container_copy_construction(other.get_allocator())) {}
+
+            unrolled_circular_list(unrolled_circular_list&& other) noexcept : alloc(other.alloc) {steal(other);}
+
+            ~unrolled_circular_list() {clear();}
+
+            unrolled_circular_list& operator=(const unrolled_circular_list& other)
+            {
+                if (this != &other)
+                {
+                    clear();
+                    copy_alloc(other.alloc,typename chunk_traits::propagate_on_container_copy_assignment());
+                    for (const_iterator iter = other.begin();iter != other.end();++iter) push_back(*iter);
+                }
+                return *this;
+            }
+
+            unrolled_circular_list& operator=(unrolled_circular_list&& other) noexcept(chunk_traits::propagate_on_container_move_assignment::value || chunk_traits::is_always_equal::value)
+            {
+                if (this != &other)
+                {
+                    clear();
+                    if (chunk_traits::propagate_on_container_move_assignment::value || alloc == other.alloc)
+                    {
+                        move_alloc(other.alloc,typename chunk_traits::propagate_on_container_move_assignment());
+                        steal(other);
+                    }
+                    else
+                    {
+                        for (iterator iter = other.begin();iter != other.end();++iter) push_back(std::move(*iter));
+                        other.clear();
+                    }
+                }
+                return *this;
+            }
+
+            allocator_type get_allocator() const noexcept {return allocator_type(alloc);}
+
+            [[nodiscard]] bool empty() const {return length == 0;}
+            [[nodiscard]] size_type size() const {return length;}
+
+            iterator begin() noexcept {return iterator(head.next,0,&head);}
+            iterator end() noexcept {return iterator(&head,0,&head);}
+            const_iterator begin() const noexcept {return const_iterator(head.next,0,&head);}
+            const_iterator end() const noexcept {return const_iterator(const_cast<chunk_base*>(&head),0,&head);}
+            const_iterator cbegin() const noexcept {return begin();}
+            const_iterator cend() const noexcept {return end();}
+
+            value_type& front()
+            {
+                if (empty()) throw std::out_of_range("List Is Empty!");
+                return as_chunk(head.next)->data()[0];
+            }
+
+            const value_type& front() const
+            {
+                if (empty()) throw std::out_of_range("List Is Empty!");
+                return as_chunk(head.next)->data()[0];
+            }
+
+            value_type& back()
+            {
+                if (empty()) throw std::out_of_range("List Is Empty!");
+                return as_chunk(head.prev)->data()[as_chunk(head.prev)->count - 1];
+            }
+
+            const value_type& back() const
+            {
+                if (empty()) throw std::out_of_range("List Is Empty!");
+                return as_chunk(head.prev)->data()[as_chunk(head.prev)->count - 1];
+            }
+
+            void clear()
+            {
+                while (head.next != &head) destroy_chunk(as_chunk(head.next));
+                length = 0;
+            }
+
+            template <typename... Args>
+              iterator emplace(iterator pos,Args&&... args) {return emplace_at(pos._chunk,pos._index,std::forward<Args>(args)...);}
+
+            iterator insert(iterator pos,const value_type& val) {return emplace(pos,val);}
+            iterator insert(iterator pos,value_type&& val) {return emplace(pos,std::move(val));}
+
+            template <typename... Args>
+              void emplace_back(Args&&... args) {emplace_at(&head,0,std::forward<Args>(args)...);}
+
+            template <typename... Args>
+              void emplace_front(Args&&... args) {emplace_at(head.next,0,std::forward<Args>(args)...);}
+
+            void push_back(const value_type& val) {emplace_back(val);}
+            void push_back(value_type&& val) {emplace_back(std::move(val));}
+            void push_front(const value_type& val) {emplace_front(val);}
+            void push_front(value_type&& val) {emplace_front(std::move(val));}
+
+            iterator erase(iterator pos)
+            {
+                if (pos._chunk == &head) return end();
+                chunk* c = as_chunk(pos._chunk);
+                size_type i = pos._index;
+                std::move(c->data() + i + 1,c->data() + c->count,c->data() + i);
+                c->data()[--c->count].~_Tp();
+                length--;
+                if (c->count == 0)
+                {
+                    chunk_base* next = c->next;
+                    destroy_chunk(c);
+                    return iterator(next,0,&head);
+                }
+                if (c->count < _ChunkSize / 4 && c->next != &head && c->count + as_chunk(c->next)->count <= _ChunkSize)
+                {
+                    chunk* n = as_chunk(c->next);
+                    std::uninitialized_move(n->data(),n->data() + n->count,c->data() + c->count);
+                    std::destroy(n->data(),n->data() + n->count);
+                    c->count += n->count;
+                    n->count = 0;
+                    destroy_chunk(n);
+                }
+                if (i < c->count) return iterator(c,i,&head);
+                return iterator(c->next,0,&head);
+            }
+
+            void pop_back()
+            {
+                if (empty()) throw std::out_of_range("List Is Empty!");
+                erase(iterator(head.prev,as_chunk(head.prev)->count - 1,&head));
+            }
+
+            void pop_front()
+            {
+                if (empty()) throw std::out_of_range("List Is Empty!");
+                erase(begin());
+            }
+
+            value_type& operator[](int pos)
+            {
+                if (pos < 0 || static_cast<size_type>(pos) >= size()) throw std::out_of_range("Position out of range");
+                size_type idx = static_cast<size_type>(pos);
+                if (idx < length / 2)
+                {
+                    chunk_base* c = head.next;
+                    while (idx >= as_chunk(c)->count)
+                    {
+                        idx -= as_chunk(c)->count;
+                        c = c->next;
+                    }
+                    return as_chunk(c)->data()[idx];
+                }
+                size_type back_idx = length - 1 - idx;
+                chunk_base* c = head.prev;
+                while (back_idx >= as_chunk(c)->count)
+                {
+                    back_idx -= as_chunk(c)->count;
+                    c = c->prev;
+                }
+                return as_chunk(c)->data()[as_chunk(c)->count - 1 - back_idx];
+            }
+
+            iterator find(const value_type& val)
+            {
+                for (chunk_base* b = head.next;b != &head;b = b->next)
+                {
+                    chunk* c = as_chunk(b);
+                    _Tp* hit = std::find(c->data(),c->data() + c->count,val);
+                    if (hit != c->data() + c->count) return iterator(c,hit - c->data(),&head);
+                }
+                return end();
+            }
+
+            template<typename Compare>
+              void remove_if(Compare pred)
+            {
+                chunk_base* b = head.next;
+                while (b != &head)
+                {
+                    chunk* c = as_chunk(b);
+                    b = b->next;
+                    _Tp* d = c->data();
+                    size_type w = 0;
+                    for (size_type r = 0;r < c->count;r++)
+                    {
+                        if (pred(d[r])) continue;
+                        if (w != r) d[w] = std::move(d[r]);
+                        w++;
+                    }
+                    compact(c,w);
+                    if (c->count == 0) destroy_chunk(c);
+                }
+            }
+
+            void remove(const value_type& remove_val) {remove_if([&](const value_type& a) {return a == remove_val;});}
+
+            void unique()
+            {
+                const _Tp* last = nullptr;
+                chunk_base* b = head.next;
+                while (b != &head)
+                {
+                    chunk* c = as_chunk(b);
+                    b = b->next;
+                    _Tp* d = c->data();
+                    size_type w = 0;
+                    for (size_type r = 0;r < c->count;r++)
+                    {
+                        if (last && *last == d[r]) continue;
+                        if (w != r) d[w] = std::move(d[r]);
+                        last = d + w;
+                        w++;
+                    }
+                    compact(c,w);
+                    if (c->count == 0) destroy_chunk(c);
+                }
+            }
+
+            void reverse()
+            {
+                chunk_base* b = &head;
+                do
+                {
+                    std::swap(b->next,b->prev);
+                    if (b != &head) std::reverse(as_chunk(b)->data(),as_chunk(b)->data() + as_chunk(b)->count);
+                    b = b->prev;
+                }
+                while (b != &head);
+            }
+
+            void sort() {sort([](const value_type& a,const value_type& b) {return a < b;});}
+
+            // Stable. Each chunk is sorted in place, then runs of chunks are
+            // merged bottom-up into freshly packed chunks, recycling the emptied
+            // ones; extra memory is two chunks, whatever the length. If comp
+            // throws, every element is still in the list, in unspecified order.
+            // Types whose move may throw take sort_in_place instead, which only
+            // promises what std::inplace_merge does.
+            template <typename Comp>
+              void sort(Comp comp)
+            {
+                if (length < 2) return;
+                if constexpr (!std::is_nothrow_move_constructible<_Tp>::value)
+                {
+                    sort_in_place(comp);
+                    return;
+                }
+                else
+                {
+                    chunk_run bins[64] = {};
+                    chunk_run carry = {nullptr,nullptr};
+                    chunk_run result = {nullptr,nullptr};
+                    chunk_base* spare = nullptr;
+                    size_type spares = 0;
+                    int fill = 0;
+                    chunk_base* rest = head.next;
+                    head.prev->next = nullptr;
+                    head.next = head.prev = &head;
+                    try
+                    {
+                        auto merge = [&](chunk_run& a,chunk_run& b)
+                        {
+                            for (;spares < 2;spares++)
+                            {
+                                chunk* c = make_chunk();
+                                c->next = spare;
+                                spare = c;
+                            }
+                            chunk_run merged = merge_runs(a,b,comp,spare);
+                            spares = 0;
+                            for (chunk_base** p = &spare;*p;)
+                            {
+                                if (spares < 2)
+                                {
+                                    spares++;
+                                    p = &(*p)->next;
+                                    continue;
+                                }
+                                chunk_base* c = *p;
+                                *p = c->next;
+                                free_chunk(as_chunk(c));
+                            }
+                            return merged;
+                        };
+                        while (rest)
+                        {
+                            chunk* c = as_chunk(rest);
+                            rest = rest->next;
+                            run_append(carry,c,c);
+                            insertion_sort(c,comp);
+                            int i = 0;
+                            for (;i < fill && bins[i].first;i++)
+                            {
+                                carry = merge(bins[i],carry);
+                                bins[i].first = bins[i].last = nullptr;
+                            }
+                            bins[i] = carry;
+                            carry.first = carry.last = nullptr;
+                            if (i == fill) fill++;
+                        }
+                        for (int i = 0;i < fill;i++)
+                        {
+                            if (!bins[i].first) continue;
+                            if (result.first) result = merge(bins[i],result);
+                            else result = bins[i];
+                            bins[i].first = bins[i].last = nullptr;
+                        }
+                    }
+                    catch (...)
+                    {
+                        for (int i = fill - 1;i >= 0;i--) ring_append(bins[i].first);
+                        ring_append(result.first);
+                        ring_append(carry.first);
+                        ring_append(rest);
+                        while (spare)
+                        {
+                            chunk_base* next = spare->next;
+                            free_chunk(as_chunk(spare));
+                            spare = next;
+                        }
+                        throw;
+                    }
+                    ring_append(result.first);
+                    while (spare)
+                    {
+                        chunk_base* next = spare->next;
+                        free_chunk(as_chunk(spare));
+                        spare = next;
+                    }
+                }
+            }
+
+            std::vector<value_type> to_vector() const
+            {
+                std::vector<value_type> vec;
+                vec.reserve(length);
+                for (const chunk_base* b = head.next;b != &head;b = b->next) vec.insert(vec.end(),as_chunk(b)->data(),as_chunk(b)->data() + as_chunk(b)->count);
+                return vec;
+            }
+    };
+_GLIBCXX_END_NAMESPACE_CONTAINER
+}
+#endif
@@ -0,0 +1,133 @@
+#ifndef _STL_WINDOWED_CIRCULAR_QUEUE_H_
+#define _STL_WINDOWED_CIRCULAR_QUEUE_H_ 1
+
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace std
+{
+	// Monoids for windowed_circular_queue: an associative operator plus its
+	// identity. Operands are passed oldest first, so non-commutative ones work.
+	template <typename _Tp>
+	  struct circular_sum
+	{
+		static _Tp identity() {return _Tp();}
+		_Tp operator()(const _Tp& a,const _Tp& b) const {return a + b;}
+	};
+
+	template <typename _Tp>
+	  struct circular_min
+	{
+		static _Tp identity() {return std::numeric_limits<_Tp>::max();}
+		_Tp operator()(const _Tp& a,const _Tp& b) const {return b < a ? b : a;}
+	};
+
+	template <typename _Tp>
+	  struct circular_max
+	{
+		static _Tp identity() {return std::numeric_limits<_Tp>::lowest();}
+		_Tp operator()(const _Tp& a,const _Tp& b) const {return a < b ? b : a;}
+	};
+
+	// Fixed-capacity circular_queue that keeps the _Monoid fold of its contents
+	// up to date, for rolling sum/min/max over the last N samples. Uses the two
+	// stacks scheme on the ring itself: the older part stores suffix folds next
+	// to each element, the newer part is folded into one running value. When the
+	// older part runs out on dequeue, the whole ring is re-folded once; each
+	// element is re-folded at most once, so every operation is amortised O(1)
+	// and no inverse operator is needed.
+	template <typename _Tp,typename _Monoid = circular_sum<_Tp> >
+	  class windowed_circular_queue
+	{
+		private:
+			struct entry
+			{
+				_Tp value;
+				_Tp fold;
+
+				entry(const _Tp& v,const _Tp& f) : value(v),fold(f) {}
+			};
+
+			circular_queue<entry> ring;
+			size_t front_count;
+			_Tp back_fold;
+			_Monoid op;
+			circular_overflow overflow;
+			size_t dropped_count;
+
+			void refold()
+			{
+				typename circular_queue<entry>::iterator first = ring.begin();
+				_Tp acc = _Monoid::identity();
+				for (size_t i = ring.size();i > 0;i--)
+				{
+					acc = op(first[i - 1].value,acc);
+					first[i - 1].fold = acc;
+				}
+				front_count = ring.size();
+				back_fold = _Monoid::identity();
+			}
+
+		public:
+			typedef size_t size_type;
+			typedef _Tp value_type;
+
+			explicit windowed_circular_queue(size_type cap,circular_overflow mode = circular_overflow::reject,_Monoid m = _Monoid()) : ring(cap),front_count(0),back_fold(_Monoid::identity()),op(m),overflow(mode),dropped_count(0) {}
+
+			// With overwrite_oldest a full window slides: the oldest sample is
+			// dropped and the new one always accepted.
+			bool enqueue(const value_type& value)
+			{
+				if (ring.is_full())
+				{
+					if (overflow != circular_overflow::overwrite_oldest) return false;
+					dequeue();
+					dropped_count++;
+				}
+				ring.enqueue(entry(value,value));
+				back_fold = op(back_fold,value);
+				return true;
+			}
+
+			bool dequeue()
+			{
+				if (ring.isEmpty()) return false;
+				if (front_count == 0) refold();
+				ring.dequeue();
+				front_count--;
+				return true;
+			}
+
+			// Fold of every element, oldest to newest; identity() when empty.
+			value_type aggregate() const {return front_count ? op(ring.begin()->fold,back_fold) : back_fold;}
+
+			value_type front() const
+			{
+				if (ring.isEmpty()) throw std::runtime_error("Queue is empty");
+				return ring.begin()->value;
+			}
+
+			value_type rear() const
+			{
+				if (ring.isEmpty()) throw std::runtime_error("Queue is empty");
+				return (ring.end() - 1)->value;
+			}
+
+			void clear()
+			{
+				while (!ring.isEmpty()) ring.dequeue();
+				front_count = 0;
+				back_fold = _Monoid::identity();
+			}
+
+			bool isEmpty() const {return ring.isEmpty();}
+			bool is_full() const {return ring.is_full();}
+			size_type size() const {return ring.size();}
+			size_type getcapacity() const {return ring.getcapacity();}
+			size_type dropped() const {return dropped_count;}
+			circular_overflow overflow_mode() const {return overflow;}
+			void set_overflow_mode(circular_overflow mode) {overflow = mode;}
+	};
+}
+#endif
@@ -0,0 +1,28 @@
+#ifndef _CIRCULAR_CHECK_H_
+#define _CIRCULAR_CHECK_H_ 1
+
+#include <cstdio>
+#include <cstdlib>
+
+// Unlike assert, stays active in release builds, which is what the benchmarks
+// are built as.
+#define CHECK(cond) \
+	do \
+	{ \
+		if (!(cond)) \
+		{ \
+			std::fprintf(stderr,"%s:%d: CHECK(%s) failed\n",__FILE__,__LINE__,#cond); \
+			std::abort(); \
+		} \
+	} while (0)
+
+#define CHECK_THROWS(expr,type) \
+	do \
+	{ \
+		bool thrown = false; \
+		try {expr;} \
+		catch (const type&) {thrown = true;} \
+		CHECK(thrown); \
+	} while (0)
+
+#endif
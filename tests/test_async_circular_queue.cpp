@@ -0,0 +1,160 @@
+#include <async_circular_queue>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "check.h"
+
+// async_circular_queue and circular_executor (C++20): FIFO order through a
+// small ring with suspended pushers and poppers, the non-suspending forms,
+// and producers and consumers resumed on a pool of executor threads.
+
+namespace
+{
+	typedef std::async_circular_queue<int> int_queue;
+
+	std::circular_detached_task produce(int_queue& q,int from,int count)
+	{
+		for (int i = from;i < from + count;i++) co_await q.push(i);
+	}
+
+	std::circular_detached_task consume(int_queue& q,int count,std::vector<int>& out)
+	{
+		for (int i = 0;i < count;i++) out.push_back(co_await q.pop());
+	}
+
+	void test_fifo_single_thread()
+	{
+		std::circular_executor ex(2);
+		int_queue q(2,ex);
+		std::vector<int> got;
+		// The consumer starts first and suspends on an empty queue; the
+		// producer then fills the ring and suspends on a full one.
+		ex.spawn(consume(q,100,got));
+		ex.spawn(produce(q,0,100));
+		ex.run_until_idle();
+		CHECK(got.size() == 100);
+		for (int i = 0;i < 100;i++) CHECK(got[i] == i);
+		CHECK(q.isEmpty());
+
+		got.clear();
+		ex.spawn(produce(q,0,5));
+		ex.run_until_idle();
+		CHECK(q.is_full());
+		CHECK(q.size() == 2);
+		int v = -1;
+		CHECK(q.try_pop(v) && v == 0);
+		// The freed slot went to the suspended producer, which is queued on
+		// the executor rather than resumed inline.
+		CHECK(q.is_full());
+		CHECK(!q.try_push(99));
+		ex.spawn(consume(q,4,got));
+		ex.run_until_idle();
+		CHECK(got == std::vector<int>({1,2,3,4}));
+		CHECK(q.isEmpty());
+		CHECK(q.try_push(7));
+		CHECK(q.try_pop(v) && v == 7);
+		CHECK(!q.try_pop(v));
+	}
+
+	void test_direct_handoff()
+	{
+		std::circular_executor ex;
+		std::async_circular_queue<std::string> q(1,ex);
+		std::vector<std::string> got;
+		auto take = [](std::async_circular_queue<std::string>& q,std::vector<std::string>& out) -> std::circular_detached_task
+		{
+			out.push_back(co_await q.pop());
+		};
+		ex.spawn(take(q,got));
+		ex.spawn(take(q,got));
+		ex.run_until_idle();
+		// Both poppers wait; a push goes straight to the first of them.
+		CHECK(q.try_push(std::string(40,'x')));
+		CHECK(q.isEmpty());
+		CHECK(q.try_push("y"));
+		CHECK(q.try_push("z"));
+		CHECK(!q.try_push("w"));
+		CHECK(ex.run_until_idle() == 2);
+		CHECK(got == std::vector<std::string>({std::string(40,'x'),"y"}));
+		CHECK(q.size() == 1);
+	}
+
+	void test_pending_frames_destroyed()
+	{
+		std::vector<int> got;
+		{
+			std::circular_executor ex;
+			int_queue q(1,ex);
+			ex.spawn(consume(q,10,got));
+			ex.spawn(produce(q,0,3));
+		}
+		CHECK(got.empty());
+	}
+
+	std::circular_detached_task produce_tagged(std::async_circular_queue<uint64_t>& q,uint64_t tag,uint64_t count)
+	{
+		for (uint64_t i = 0;i < count;i++) co_await q.push((tag << 32) | i);
+	}
+
+	std::circular_detached_task consume_tagged(std::async_circular_queue<uint64_t>& q,uint64_t count,std::vector<uint64_t>& out,std::atomic<unsigned>& done,std::circular_executor& ex,unsigned total)
+	{
+		for (uint64_t i = 0;i < count;i++) out.push_back(co_await q.pop());
+		if (done.fetch_add(1) + 1 == total) ex.stop();
+	}
+
+	void test_thread_pool()
+	{
+		const unsigned producers = 4;
+		const unsigned consumers = 4;
+		const unsigned workers = 4;
+		const uint64_t per_producer = 20000;
+		const uint64_t per_consumer = producers * per_producer / consumers;
+		std::circular_executor ex(4);
+		std::async_circular_queue<uint64_t> q(8,ex);
+		std::vector<std::vector<uint64_t> > seen(consumers);
+		std::atomic<unsigned> done(0);
+		for (unsigned c = 0;c < consumers;c++) ex.spawn(consume_tagged(q,per_consumer,seen[c],done,ex,consumers));
+		for (unsigned p = 0;p < producers;p++) ex.spawn(produce_tagged(q,p,per_producer));
+		std::vector<std::thread> pool;
+		for (unsigned w = 0;w < workers;w++) pool.emplace_back([&ex] {ex.run();});
+		for (std::thread& t : pool) t.join();
+		CHECK(done.load() == consumers);
+		CHECK(q.isEmpty());
+
+		// Each consumer sees any one producer's values in the order pushed, and
+		// together they see every value exactly once.
+		std::vector<uint64_t> all;
+		for (const std::vector<uint64_t>& s : seen)
+		{
+			CHECK(s.size() == per_consumer);
+			std::vector<uint64_t> last(producers,0);
+			std::vector<bool> any(producers,false);
+			for (uint64_t v : s)
+			{
+				uint64_t p = v >> 32;
+				uint64_t i = v & 0xffffffffu;
+				CHECK(p < producers);
+				CHECK(!any[p] || i > last[p]);
+				any[p] = true;
+				last[p] = i;
+			}
+			all.insert(all.end(),s.begin(),s.end());
+		}
+		std::sort(all.begin(),all.end());
+		CHECK(std::adjacent_find(all.begin(),all.end()) == all.end());
+		CHECK(all.size() == producers * per_producer);
+	}
+}
+
+int main()
+{
+	test_fifo_single_thread();
+	test_direct_handoff();
+	test_pending_frames_destroyed();
+	test_thread_pool();
+	return 0;
+}
@@ -0,0 +1,171 @@
+#include <concurrent_circular_queue>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include "check.h"
+
+// blocking_circular_queue: the non-blocking calls, try_pop_for timing out,
+// close() releasing parked producers and consumers, batch pops, and several
+// producers and consumers parking on a small ring.
+
+namespace
+{
+	void test_single_thread()
+	{
+		std::blocking_circular_queue<int> q(2);
+		CHECK(q.isEmpty());
+		CHECK(q.try_push(1));
+		CHECK(q.push(2));
+		CHECK(q.is_full());
+		CHECK(!q.try_push(3));
+		int v = 0;
+		CHECK(q.try_pop(v) && v == 1);
+		CHECK(q.pop(v) && v == 2);
+		CHECK(!q.try_pop(v));
+		CHECK(q.size() == 0);
+	}
+
+	void test_try_pop_for_timeout()
+	{
+		std::blocking_circular_queue<int> q(4);
+		int v = 0;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		CHECK(!q.try_pop_for(v,std::chrono::milliseconds(20)));
+		CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+		std::thread producer([&q]
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			q.push(42);
+		});
+		CHECK(q.try_pop_for(v,std::chrono::seconds(10)) && v == 42);
+		producer.join();
+	}
+
+	void test_close_wakes_waiters()
+	{
+		std::blocking_circular_queue<int> empty(1);
+		std::blocking_circular_queue<int> full(1);
+		CHECK(full.push(0));
+		std::atomic<int> released(0);
+		std::vector<std::thread> threads;
+		for (int i = 0;i < 3;i++)
+		{
+			threads.emplace_back([&empty,&released]
+			{
+				int v;
+				if (!empty.pop(v)) released++;
+			});
+			threads.emplace_back([&full,&released]
+			{
+				if (!full.push(1)) released++;
+			});
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		empty.close();
+		full.close();
+		for (std::thread& t : threads) t.join();
+		CHECK(released == 6);
+
+		// A closed queue refuses pushes but still drains.
+		CHECK(full.is_closed());
+		CHECK(!full.try_push(2));
+		int v = -1;
+		CHECK(full.pop(v) && v == 0);
+		CHECK(!full.pop(v));
+	}
+
+	void test_pop_n()
+	{
+		std::blocking_circular_queue<int> q(8);
+		for (int i = 0;i < 5;i++) q.push(i);
+		std::vector<int> out;
+		CHECK(q.pop_n(std::back_inserter(out),3) == 3);
+		CHECK(q.pop_n(std::back_inserter(out),10) == 2);
+		CHECK(out == std::vector<int>({0,1,2,3,4}));
+		CHECK(q.pop_n(std::back_inserter(out),0) == 0);
+
+		std::thread producer([&q]
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			for (int i = 5;i < 8;i++) q.push(i);
+		});
+		size_t taken = 0;
+		while (taken < 3) taken += q.pop_n(std::back_inserter(out),8);
+		producer.join();
+		CHECK(out == std::vector<int>({0,1,2,3,4,5,6,7}));
+		q.close();
+		CHECK(q.pop_n(std::back_inserter(out),8) == 0);
+	}
+
+	void test_stress()
+	{
+		const unsigned producers = 3;
+		const unsigned consumers = 3;
+		const uint64_t per_producer = 20000;
+		std::blocking_circular_queue<uint64_t,std::circular_queue_atomic_stats> q(4);
+		std::vector<std::vector<uint64_t> > seen(consumers);
+		std::vector<std::thread> threads;
+		for (unsigned p = 0;p < producers;p++)
+		{
+			threads.emplace_back([&q,p,per_producer]
+			{
+				for (uint64_t i = 0;i < per_producer;i++) CHECK(q.push((uint64_t(p) << 32) | i));
+			});
+		}
+		for (unsigned c = 0;c < consumers;c++)
+		{
+			threads.emplace_back([&q,&seen,c]
+			{
+				uint64_t batch[3];
+				for (;;)
+				{
+					size_t n = c == 0 ? q.pop_n(batch,3) : (q.pop(batch[0]) ? 1 : 0);
+					if (n == 0) break;
+					seen[c].insert(seen[c].end(),batch,batch + n);
+				}
+			});
+		}
+		for (unsigned p = 0;p < producers;p++) threads[p].join();
+		q.close();
+		for (unsigned c = 0;c < consumers;c++) threads[producers + c].join();
+		CHECK(q.isEmpty());
+
+		// Every value exactly once, each producer's values in order per consumer.
+		std::vector<std::vector<bool> > got(producers,std::vector<bool>(per_producer,false));
+		for (const std::vector<uint64_t>& values : seen)
+		{
+			std::vector<int64_t> last(producers,-1);
+			for (uint64_t v : values)
+			{
+				unsigned p = static_cast<unsigned>(v >> 32);
+				int64_t i = static_cast<int64_t>(v & 0xffffffffu);
+				CHECK(p < producers);
+				CHECK(i > last[p]);
+				last[p] = i;
+				CHECK(!got[p][i]);
+				got[p][i] = true;
+			}
+		}
+		for (const std::vector<bool>& flags : got)
+			for (bool f : flags) CHECK(f);
+		std::circular_queue_stats s = q.stats();
+		CHECK(s.enqueues == producers * per_producer);
+		CHECK(s.dequeues == producers * per_producer);
+		CHECK(s.high_water <= 4);
+	}
+}
+
+int main()
+{
+	test_single_thread();
+	test_try_pop_for_timeout();
+	test_close_wakes_waiters();
+	test_pop_n();
+	test_stress();
+	return 0;
+}
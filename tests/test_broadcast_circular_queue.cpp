@@ -0,0 +1,153 @@
+#include <concurrent_circular_queue>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "check.h"
+
+// broadcast_circular_queue: bulk publishing, every consumer seeing the whole
+// stream in order, upstream dependencies holding a stage back, and what the
+// stats policy counts.
+
+namespace
+{
+	typedef std::broadcast_circular_queue<uint64_t,std::circular_queue_atomic_stats> stats_ring;
+
+	void test_try_enqueue_n()
+	{
+		CHECK_THROWS(std::broadcast_circular_queue<int>(0),std::invalid_argument);
+		std::broadcast_circular_queue<int,std::circular_queue_atomic_stats> q(4);
+		std::broadcast_circular_queue<int,std::circular_queue_atomic_stats>::consumer& c = q.add_consumer();
+		std::vector<int> values = {0,1,2,3,4,5,6,7,8,9};
+		CHECK(q.try_enqueue_n(values.begin(),values.end()) == 4);
+		CHECK(q.is_full());
+		CHECK(!q.try_enqueue(10));
+		CHECK(q.stats().rejected == 7);
+		CHECK(c.available() == 4);
+		std::vector<int> got;
+		CHECK(c.consume([&got](const int& v) {got.push_back(v);},2) == 2);
+		CHECK(q.size() == 2);
+		CHECK(q.try_enqueue_n(values.begin() + 4,values.end()) == 2);
+		// The cached limit still stops at 4; the next call sees the new two.
+		CHECK(c.consume([&got](const int& v) {got.push_back(v);}) == 2);
+		CHECK(c.consume([&got](const int& v) {got.push_back(v);}) == 2);
+		CHECK(got == std::vector<int>({0,1,2,3,4,5}));
+		CHECK(c.sequence() == 6);
+		CHECK(q.sequence() == 6);
+		CHECK(q.try_enqueue_n(values.begin(),values.begin()) == 0);
+
+		// A single-pass range is charged one rejection, not one per leftover.
+		std::istringstream in("10 11 12 13 14 15");
+		CHECK(q.try_enqueue_n(std::istream_iterator<int>(in),std::istream_iterator<int>()) == 4);
+		std::circular_queue_stats s = q.stats();
+		CHECK(s.enqueues == 10);
+		CHECK(s.rejected == 7 + 4 + 1);
+		CHECK(s.dequeues == 6);
+		int v = 0;
+		CHECK(c.try_dequeue(v) && v == 10);
+	}
+
+	void test_late_consumer()
+	{
+		std::broadcast_circular_queue<int> q(8);
+		std::broadcast_circular_queue<int>::consumer& early = q.add_consumer();
+		CHECK(q.try_enqueue(1));
+		CHECK(q.try_enqueue(2));
+		std::broadcast_circular_queue<int>::consumer& late = q.add_consumer();
+		CHECK(late.available() == 0);
+		CHECK(q.try_enqueue(3));
+		int v = 0;
+		CHECK(late.try_dequeue(v) && v == 3);
+		CHECK(early.available() == 3);
+		CHECK(q.size() == 3);
+		CHECK(early.consume([](const int&) {}) == 3);
+		CHECK(q.isEmpty());
+	}
+
+	void test_every_consumer_in_order()
+	{
+		const unsigned readers = 3;
+		const uint64_t items = 200000;
+		stats_ring q(64);
+		std::vector<stats_ring::consumer*> consumers;
+		for (unsigned i = 0;i < readers;i++) consumers.push_back(&q.add_consumer());
+		std::vector<std::thread> threads;
+		for (unsigned i = 0;i < readers;i++)
+		{
+			threads.emplace_back([&consumers,i,items]
+			{
+				uint64_t expect = 0;
+				while (expect < items)
+				{
+					consumers[i]->spin_consume([&expect](const uint64_t& v)
+					{
+						CHECK(v == expect);
+						expect++;
+					},static_cast<size_t>(i + 1) * 7);
+				}
+			});
+		}
+		for (uint64_t i = 0;i < items;i++) q.spin_enqueue(i);
+		for (std::thread& t : threads) t.join();
+		CHECK(q.isEmpty());
+		std::circular_queue_stats s = q.stats();
+		CHECK(s.enqueues == items);
+		CHECK(s.rejected == 0);
+		CHECK(s.dequeues == items * readers);
+		CHECK(s.high_water <= 64);
+		CHECK(s.allocations == 1);
+	}
+
+	// A three-stage pipeline over one ring: 'decode' reads first, 'check'
+	// must stay behind it, and 'log' behind both. Each stage marks the
+	// sequences it has finished; a later stage must never find its upstream's
+	// mark missing.
+	void test_upstream_dependencies()
+	{
+		const uint64_t items = 100000;
+		std::broadcast_circular_queue<uint64_t> q(32);
+		std::broadcast_circular_queue<uint64_t>::consumer& decode = q.add_consumer();
+		std::broadcast_circular_queue<uint64_t>::consumer& check = q.add_consumer({&decode});
+		std::broadcast_circular_queue<uint64_t>::consumer& log = q.add_consumer({&decode,&check});
+		std::unique_ptr<std::atomic<unsigned char>[]> stage(new std::atomic<unsigned char>[items]);
+		for (uint64_t i = 0;i < items;i++) stage[i].store(0,std::memory_order_relaxed);
+
+		auto run = [&stage,items](std::broadcast_circular_queue<uint64_t>::consumer& c,unsigned char need)
+		{
+			uint64_t expect = 0;
+			while (expect < items)
+			{
+				c.spin_consume([&](const uint64_t& v)
+				{
+					CHECK(v == expect);
+					CHECK(stage[v].load(std::memory_order_relaxed) == need);
+					stage[v].store(need + 1,std::memory_order_relaxed);
+					expect++;
+				},5);
+			}
+		};
+		std::thread t1([&] {run(decode,0);});
+		std::thread t2([&] {run(check,1);});
+		std::thread t3([&] {run(log,2);});
+		for (uint64_t i = 0;i < items;i++) q.spin_enqueue(i);
+		t1.join();
+		t2.join();
+		t3.join();
+		CHECK(log.sequence() == items);
+		for (uint64_t i = 0;i < items;i++) CHECK(stage[i].load(std::memory_order_relaxed) == 3);
+	}
+}
+
+int main()
+{
+	test_try_enqueue_n();
+	test_late_consumer();
+	test_every_consumer_in_order();
+	test_upstream_dependencies();
+	return 0;
+}
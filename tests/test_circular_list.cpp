@@ -0,0 +1,147 @@
+#include <circular_list>
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "check.h"
+
+// The operations the list benchmark times, checked against std::list.
+
+namespace
+{
+	typedef std::circular_list<int> clist;
+
+	std::vector<int> contents(const std::list<int>& l) {return std::vector<int>(l.begin(),l.end());}
+
+	void test_ends()
+	{
+		clist l;
+		CHECK(l.empty());
+		CHECK_THROWS(l.front(),std::out_of_range);
+		CHECK_THROWS(l.pop_front(),std::out_of_range);
+		for (int i = 0;i < 10;i++) l.push_back(i);
+		l.push_front(-1);
+		CHECK(l.size() == 11);
+		CHECK(l.front() == -1);
+		CHECK(l.back() == 9);
+		l.pop_front();
+		l.pop_back();
+		CHECK(l.to_vector() == std::vector<int>({0,1,2,3,4,5,6,7,8}));
+		l.clear();
+		CHECK(l.empty());
+		CHECK(l.to_vector().empty());
+	}
+
+	void test_random_ops()
+	{
+		std::mt19937 gen(7);
+		clist l;
+		std::list<int> ref;
+		for (int step = 0;step < 20000;step++)
+		{
+			int v = static_cast<int>(gen() % 1000);
+			switch (gen() % 8)
+			{
+				case 0: l.push_back(v);ref.push_back(v);break;
+				case 1: l.push_front(v);ref.push_front(v);break;
+				case 2:
+					if (!ref.empty())
+					{
+						l.pop_front();
+						ref.pop_front();
+					}
+					break;
+				case 3:
+				{
+					size_t at = ref.empty() ? 0 : gen() % (ref.size() + 1);
+					clist::iterator pos = at == ref.size() ? l.end() : std::next(l.begin(),static_cast<ptrdiff_t>(at));
+					l.insert(pos,v);
+					ref.insert(std::next(ref.begin(),static_cast<ptrdiff_t>(at)),v);
+					break;
+				}
+				case 4:
+					if (!ref.empty())
+					{
+						size_t at = gen() % ref.size();
+						l.erase(std::next(l.begin(),static_cast<ptrdiff_t>(at)));
+						ref.erase(std::next(ref.begin(),static_cast<ptrdiff_t>(at)));
+					}
+					break;
+				case 5:
+					if (!ref.empty())
+					{
+						size_t at = gen() % ref.size();
+						CHECK(l[static_cast<int>(at)] == *std::next(ref.begin(),static_cast<ptrdiff_t>(at)));
+						int target = *std::next(ref.begin(),static_cast<ptrdiff_t>(at));
+						CHECK(*l.find(target) == target);
+					}
+					break;
+				case 6:
+					if (gen() % 64 == 0)
+					{
+						l.reverse();
+						ref.reverse();
+					}
+					break;
+				default:
+					if (gen() % 128 == 0)
+					{
+						l.sort();
+						ref.sort();
+					}
+					break;
+			}
+			CHECK(l.size() == ref.size());
+		}
+		CHECK(l.to_vector() == contents(ref));
+	}
+
+	void test_splice()
+	{
+		clist a = {1,2,3};
+		clist b = {4,5,6};
+		a.splice(a.end(),b);
+		CHECK(b.empty());
+		CHECK(a.size() == 6);
+		CHECK(a.to_vector() == std::vector<int>({1,2,3,4,5,6}));
+		b.splice(b.end(),a);
+		CHECK(a.empty());
+		CHECK(b.to_vector() == std::vector<int>({1,2,3,4,5,6}));
+		b.push_back(7);
+		CHECK(b.back() == 7);
+	}
+
+	void test_index()
+	{
+		clist l = {10,20,30};
+		CHECK(l[0] == 10);
+		CHECK(l[2] == 30);
+		CHECK_THROWS(l[3],std::out_of_range);
+		CHECK_THROWS(l[-1],std::out_of_range);
+	}
+
+	void test_sort_stable()
+	{
+		std::mt19937 gen(3);
+		std::vector<std::pair<int,int> > values;
+		for (int i = 0;i < 5000;i++) values.push_back(std::make_pair(static_cast<int>(gen() % 50),i));
+		std::circular_list<std::pair<int,int> > l(values.begin(),values.end());
+		auto by_key = [](const std::pair<int,int>& a,const std::pair<int,int>& b) {return a.first < b.first;};
+		l.sort(by_key);
+		std::stable_sort(values.begin(),values.end(),by_key);
+		CHECK(l.to_vector() == values);
+	}
+}
+
+int main()
+{
+	test_ends();
+	test_random_ops();
+	test_splice();
+	test_index();
+	test_sort_stable();
+	return 0;
+}
@@ -0,0 +1,208 @@
+#include <circular_list>
+#include <circular_queue>
+#include <deque>
+#include <forward_list>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <queue>
+#include <stack>
+#include <utility>
+#include <vector>
+
+#include "check.h"
+
+// The to_*() conversions: the const& forms copy and leave the list alone;
+// the && forms move every element out, copy none, and leave the source empty
+// and still usable. Move-only elements must compile through the && forms.
+
+namespace
+{
+	struct counted
+	{
+		static int copies;
+		int value;
+
+		counted(int v = 0) : value(v) {}
+		counted(const counted& other) : value(other.value) {copies++;}
+		counted(counted&& other) noexcept : value(other.value) {other.value = -1;}
+		counted& operator=(const counted& other)
+		{
+			value = other.value;
+			copies++;
+			return *this;
+		}
+		counted& operator=(counted&& other) noexcept
+		{
+			value = other.value;
+			other.value = -1;
+			return *this;
+		}
+	};
+
+	int counted::copies = 0;
+
+	typedef std::circular_list<counted> counted_list;
+	typedef std::circular_list<std::unique_ptr<int> > ptr_list;
+
+	counted_list make_counted(int n)
+	{
+		counted_list l;
+		for (int i = 0;i < n;i++) l.emplace_back(i);
+		return l;
+	}
+
+	ptr_list make_ptrs(int n)
+	{
+		ptr_list l;
+		for (int i = 0;i < n;i++) l.push_back(std::unique_ptr<int>(new int(i)));
+		return l;
+	}
+
+	template <typename _Range>
+	  std::vector<int> values(const _Range& r)
+	{
+		std::vector<int> out;
+		for (const counted& c : r) out.push_back(c.value);
+		return out;
+	}
+
+	template <typename _Range>
+	  std::vector<int> pointees(const _Range& r)
+	{
+		std::vector<int> out;
+		for (const std::unique_ptr<int>& p : r) out.push_back(p ? *p : -1);
+		return out;
+	}
+
+	// The source is empty afterwards, and can be filled and read again.
+	template <typename _List>
+	  bool emptied_and_usable(_List& l)
+	{
+		bool ok = l.empty() && l.size() == 0;
+		l.emplace_back();
+		ok = ok && l.size() == 1;
+		l.clear();
+		return ok;
+	}
+
+	const std::vector<int> expect = {0,1,2,3,4};
+
+	void test_copies_leave_source()
+	{
+		counted_list l = make_counted(5);
+		counted::copies = 0;
+		CHECK(values(l.to_vector()) == expect);
+		CHECK(values(l.to_list()) == expect);
+		CHECK(values(l.to_deque()) == expect);
+		CHECK(values(l.to_forward_list()) == expect);
+		CHECK(counted::copies == 20);
+		CHECK(l.size() == 5);
+		CHECK(values(l.to_vector()) == expect);
+	}
+
+	void test_moves_counted()
+	{
+		counted::copies = 0;
+		{
+			counted_list l = make_counted(5);
+			CHECK(values(std::move(l).to_vector()) == expect);
+			CHECK(emptied_and_usable(l));
+		}
+		{
+			counted_list l = make_counted(5);
+			CHECK(values(std::move(l).to_list()) == expect);
+			CHECK(emptied_and_usable(l));
+		}
+		{
+			counted_list l = make_counted(5);
+			CHECK(values(std::move(l).to_deque()) == expect);
+			CHECK(emptied_and_usable(l));
+		}
+		{
+			counted_list l = make_counted(5);
+			CHECK(values(std::move(l).to_forward_list()) == expect);
+			CHECK(emptied_and_usable(l));
+		}
+		{
+			counted_list l = make_counted(5);
+			std::queue<counted> q = std::move(l).to_queue();
+			CHECK(q.size() == 5 && q.front().value == 0 && q.back().value == 4);
+			CHECK(emptied_and_usable(l));
+		}
+		{
+			counted_list l = make_counted(5);
+			std::stack<counted> s = std::move(l).to_stack();
+			CHECK(s.size() == 5 && s.top().value == 4);
+			CHECK(emptied_and_usable(l));
+		}
+		{
+			std::circular_queue<counted> q(8);
+			for (int i = 0;i < 8;i++) q.emplace(i);
+			for (int i = 0;i < 3;i++) q.dequeue();
+			counted_list l = std::move(q).to_circular_list();
+			CHECK(l.to_vector().size() == 5);
+			CHECK(q.isEmpty());
+			CHECK(q.enqueue(counted(9)));
+			CHECK(q.size() == 1);
+		}
+		// Only the l.to_vector() copy just above may copy.
+		CHECK(counted::copies == 5);
+	}
+
+	void test_move_only()
+	{
+		{
+			ptr_list l = make_ptrs(5);
+			CHECK(pointees(std::move(l).to_vector()) == expect);
+			CHECK(emptied_and_usable(l));
+		}
+		{
+			ptr_list l = make_ptrs(5);
+			CHECK(pointees(std::move(l).to_list()) == expect);
+			CHECK(emptied_and_usable(l));
+		}
+		{
+			ptr_list l = make_ptrs(5);
+			CHECK(pointees(std::move(l).to_deque()) == expect);
+			CHECK(emptied_and_usable(l));
+		}
+		{
+			ptr_list l = make_ptrs(5);
+			CHECK(pointees(std::move(l).to_forward_list()) == expect);
+			CHECK(emptied_and_usable(l));
+		}
+		{
+			ptr_list l = make_ptrs(5);
+			std::queue<std::unique_ptr<int> > q = std::move(l).to_queue();
+			CHECK(q.size() == 5 && *q.front() == 0);
+			CHECK(emptied_and_usable(l));
+		}
+		{
+			ptr_list l = make_ptrs(5);
+			std::stack<std::unique_ptr<int> > s = std::move(l).to_stack();
+			CHECK(s.size() == 5 && *s.top() == 4);
+			CHECK(emptied_and_usable(l));
+		}
+		{
+			std::circular_queue<std::unique_ptr<int> > q(4);
+			for (int i = 0;i < 4;i++) q.enqueue(std::unique_ptr<int>(new int(i)));
+			q.dequeue();
+			q.enqueue(std::unique_ptr<int>(new int(4)));
+			ptr_list l = std::move(q).to_circular_list();
+			CHECK(l.size() == 4);
+			CHECK(*l.front() == 1);
+			CHECK(*l.back() == 4);
+			CHECK(q.isEmpty());
+			CHECK(q.enqueue(std::unique_ptr<int>(new int(5))));
+		}
+	}
+}
+
+int main()
+{
+	test_copies_leave_source();
+	test_moves_counted();
+	test_move_only();
+	return 0;
+}
@@ -0,0 +1,237 @@
+#include <circular_list>
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "check.h"
+
+// circular_list rotate against std::rotate, and the round-robin cursor:
+// wrapping, and where it lands when its element is erased, spliced away or
+// the list is cleared, moved or destroyed.
+
+namespace
+{
+	typedef std::circular_list<int> clist;
+
+	clist range(int from,int to)
+	{
+		clist l;
+		for (int i = from;i < to;i++) l.push_back(i);
+		return l;
+	}
+
+	std::vector<int> take(clist::cursor& c,int n)
+	{
+		std::vector<int> out;
+		for (int i = 0;i < n;i++) out.push_back(c.next());
+		return out;
+	}
+
+	void test_rotate()
+	{
+		for (int n : {0,1,2,5,8})
+		{
+			std::vector<int> ref;
+			for (int i = 0;i < n;i++) ref.push_back(i);
+			clist l = range(0,n);
+			std::vector<const int*> nodes;
+			clist::iterator it = l.begin();
+			for (int i = 0;i < n;i++,++it) nodes.push_back(&*it);
+			for (ptrdiff_t by : {0,1,-1,3,-3,7,-7,8,17,-17,100})
+			{
+				l.rotate(by);
+				if (n > 0)
+				{
+					ptrdiff_t k = ((by % n) + n) % n;
+					std::rotate(ref.begin(),ref.begin() + k,ref.end());
+					std::rotate(nodes.begin(),nodes.begin() + k,nodes.end());
+				}
+				CHECK(l.to_vector() == ref);
+				CHECK(l.size() == static_cast<size_t>(n));
+				// No element moved: the same nodes, in the rotated order.
+				it = l.begin();
+				for (int i = 0;i < n;i++,++it) CHECK(&*it == nodes[i]);
+			}
+			if (n)
+			{
+				CHECK(l.back() == ref.back());
+				CHECK(*std::prev(l.end()) == ref.back());
+			}
+		}
+	}
+
+	void test_round_robin()
+	{
+		clist l = range(0,4);
+		clist::cursor c(l);
+		CHECK(c.attached());
+		CHECK(*c == 0);
+		CHECK(take(c,9) == std::vector<int>({0,1,2,3,0,1,2,3,0}));
+		c.advance(2);
+		CHECK(*c == 3);
+		c.advance(4);
+		CHECK(*c == 3);
+		c.advance(5);
+		CHECK(*c == 0);
+		clist::cursor at(l,std::next(l.begin(),2));
+		CHECK(*at == 2);
+		clist::cursor copy(at);
+		CHECK(take(copy,3) == std::vector<int>({2,3,0}));
+		CHECK(*at == 2);
+		copy = c;
+		CHECK(*copy == *c);
+
+		// Pushing behind the cursor puts the new element in the rotation.
+		l.push_back(4);
+		CHECK(take(c,5) == std::vector<int>({0,1,2,3,4}));
+		// The cursor follows its element, not its position, through a rotate.
+		CHECK(c.next() == 0);
+		l.rotate(2);
+		CHECK(l.to_vector() == std::vector<int>({2,3,4,0,1}));
+		CHECK(*c == 1);
+		CHECK(take(c,3) == std::vector<int>({1,2,3}));
+
+		clist::cursor loose;
+		CHECK(!loose.attached());
+		CHECK_THROWS(*loose,std::out_of_range);
+		CHECK_THROWS(loose.next(),std::out_of_range);
+		loose.advance(3);
+	}
+
+	void test_erase_moves_cursor_on()
+	{
+		clist l = range(0,6);
+		clist::cursor a(l,std::next(l.begin(),2));
+		clist::cursor b(l,std::next(l.begin(),2));
+		clist::cursor last(l,std::prev(l.end()));
+		l.erase(std::next(l.begin(),2));
+		CHECK(*a == 3);
+		CHECK(*b == 3);
+		// A range holding the cursor sends it to the first survivor after it.
+		l.erase(std::next(l.begin(),1),std::next(l.begin(),3));
+		CHECK(l.to_vector() == std::vector<int>({0,4,5}));
+		CHECK(*a == 4);
+		// The back element's successor is the sentinel; next() wraps past it.
+		l.pop_back();
+		CHECK(*last == 0);
+		CHECK(take(last,3) == std::vector<int>({0,4,0}));
+		l.remove(4);
+		CHECK(*a == 0);
+		l.clear();
+		CHECK_THROWS(*a,std::out_of_range);
+		CHECK_THROWS(a.next(),std::out_of_range);
+		l.push_back(9);
+		CHECK(*a == 9);
+		CHECK(*b == 9);
+	}
+
+	void test_splice_moves_cursor_on()
+	{
+		clist l = range(0,6);
+		clist other = range(10,12);
+		clist::cursor c(l,std::next(l.begin(),1));
+		clist::cursor stays(l,std::next(l.begin(),4));
+		other.splice(other.end(),l,std::next(l.begin(),1),std::next(l.begin(),3));
+		CHECK(l.to_vector() == std::vector<int>({0,3,4,5}));
+		CHECK(*c == 3);
+		CHECK(*stays == 4);
+		clist part = l.split(std::next(l.begin(),1),std::next(l.begin(),2));
+		CHECK(*c == 4);
+		other.splice(other.end(),l,std::next(l.begin(),1));
+		CHECK(*c == 5);
+		CHECK(*stays == 5);
+		// Splicing within the list moves nothing out; the cursor stays put.
+		l.splice(l.begin(),l,std::prev(l.end()));
+		CHECK(*c == 5);
+		CHECK(l.to_vector() == std::vector<int>({5,0}));
+		other.splice(other.end(),l);
+		CHECK(l.empty());
+		CHECK_THROWS(*c,std::out_of_range);
+	}
+
+	void test_list_lifetime()
+	{
+		clist::cursor outlives;
+		{
+			clist l = range(0,3);
+			clist::cursor c(l,std::next(l.begin(),1));
+			outlives = c;
+			clist moved(std::move(l));
+			// The cursor belongs to the moved-from list, now empty.
+			CHECK_THROWS(*c,std::out_of_range);
+			l.push_back(7);
+			CHECK(*c == 7);
+			CHECK(moved.size() == 3);
+		}
+		CHECK(!outlives.attached());
+		CHECK_THROWS(outlives.next(),std::out_of_range);
+	}
+
+	void test_random_against_model()
+	{
+		// A scheduler-style mix: run the next task, finish tasks, add tasks.
+		// Ids are unique, and the model parks the cursor on an id, or on -1
+		// for the sentinel, where the next element is the front.
+		std::mt19937 gen(12);
+		clist l = range(0,16);
+		std::vector<int> model = l.to_vector();
+		int parked = 0;
+		clist::cursor c(l);
+		int next_id = 16;
+		auto successor = [&model](int id)
+		{
+			size_t i = std::find(model.begin(),model.end(),id) - model.begin();
+			return i + 1 < model.size() ? model[i + 1] : -1;
+		};
+		for (int step = 0;step < 20000;step++)
+		{
+			if (model.empty())
+			{
+				l.push_back(next_id);
+				model.push_back(next_id++);
+			}
+			int current = parked == -1 ? model.front() : parked;
+			CHECK(*c == current);
+			switch (gen() % 4)
+			{
+				case 0:
+					CHECK(c.next() == current);
+					parked = successor(current);
+					break;
+				case 1:
+				{
+					size_t at = gen() % (model.size() + 1);
+					// Stepping past the back wraps to the front, so the end is named.
+					l.insert(at == model.size() ? l.end() : std::next(l.begin(),static_cast<ptrdiff_t>(at)),next_id);
+					model.insert(model.begin() + static_cast<ptrdiff_t>(at),next_id++);
+					break;
+				}
+				default:
+				{
+					// Finish the current task half the time, any task otherwise.
+					size_t at = gen() % 2 ? std::find(model.begin(),model.end(),current) - model.begin() : gen() % model.size();
+					int id = model[at];
+					if (parked == id) parked = successor(id);
+					l.erase(std::next(l.begin(),static_cast<ptrdiff_t>(at)));
+					model.erase(model.begin() + static_cast<ptrdiff_t>(at));
+					break;
+				}
+			}
+			CHECK(l.size() == model.size());
+			if (step % 64 == 0) CHECK(l.to_vector() == model);
+		}
+	}
+}
+
+int main()
+{
+	test_rotate();
+	test_round_robin();
+	test_erase_moves_cursor_on();
+	test_splice_moves_cursor_on();
+	test_list_lifetime();
+	test_random_against_model();
+	return 0;
+}
@@ -0,0 +1,157 @@
+#include <circular_list>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "check.h"
+
+// circular_list::partial_sort and nth_element against std::partial_sort and
+// std::nth_element, on keys with many and with no duplicates, checking the
+// prev links as well as the next links of the relinked list.
+
+namespace
+{
+	// (key, original position); the comparators only look at the key.
+	typedef std::pair<int,int> keyed;
+	typedef std::circular_list<keyed> klist;
+
+	bool by_key(const keyed& a,const keyed& b) {return a.first < b.first;}
+
+	std::vector<keyed> make(size_t n,int keys,unsigned seed)
+	{
+		std::mt19937 gen(seed);
+		std::vector<keyed> values;
+		for (size_t i = 0;i < n;i++) values.push_back(keyed(static_cast<int>(gen() % static_cast<unsigned>(keys)),static_cast<int>(i)));
+		return values;
+	}
+
+	// Walks from the back through prev links, by count since the iterator wraps.
+	std::vector<keyed> backwards(klist& l)
+	{
+		std::vector<keyed> out;
+		klist::iterator it = l.end();
+		for (size_t i = 0;i < l.size();i++) out.push_back(*--it);
+		std::reverse(out.begin(),out.end());
+		return out;
+	}
+
+	void check_partial_sort(const std::vector<keyed>& values,size_t k)
+	{
+		klist l(values.begin(),values.end());
+		l.partial_sort(k,by_key);
+		std::vector<keyed> got = l.to_vector();
+		CHECK(got.size() == values.size());
+		CHECK(backwards(l) == got);
+
+		size_t m = std::min(k,values.size());
+		std::vector<keyed> expect = values;
+		std::partial_sort(expect.begin(),expect.begin() + static_cast<ptrdiff_t>(m),expect.end(),by_key);
+		for (size_t i = 0;i < m;i++) CHECK(got[i].first == expect[i].first);
+		// Everything behind the k keeps its original order.
+		for (size_t i = m + 1;i < got.size();i++) CHECK(got[i - 1].second < got[i].second);
+		std::sort(got.begin(),got.end());
+		std::vector<keyed> all = values;
+		std::sort(all.begin(),all.end());
+		CHECK(got == all);
+	}
+
+	void check_nth_element(const std::vector<keyed>& values,size_t n)
+	{
+		klist l(values.begin(),values.end());
+		klist::iterator it = l.nth_element(n,by_key);
+		std::vector<keyed> got = l.to_vector();
+		CHECK(got.size() == values.size());
+		CHECK(backwards(l) == got);
+		CHECK(*it == got[n]);
+
+		std::vector<keyed> expect = values;
+		std::nth_element(expect.begin(),expect.begin() + static_cast<ptrdiff_t>(n),expect.end(),by_key);
+		CHECK(got[n].first == expect[n].first);
+		for (size_t i = 0;i < n;i++) CHECK(!by_key(got[n],got[i]));
+		for (size_t i = n + 1;i < got.size();i++) CHECK(!by_key(got[i],got[n]));
+		std::sort(got.begin(),got.end());
+		std::vector<keyed> all = values;
+		std::sort(all.begin(),all.end());
+		CHECK(got == all);
+	}
+
+	void test_against_std()
+	{
+		unsigned seed = 1;
+		for (size_t n : {1,2,3,10,100,1000,5000})
+		{
+			for (int keys : {3,50,1000000})
+			{
+				std::vector<keyed> values = make(n,keys,seed++);
+				for (size_t k : {size_t(0),size_t(1),n / 3,n - 1,n,n + 5}) check_partial_sort(values,k);
+				for (size_t i : {size_t(0),n / 2,n - 1}) check_nth_element(values,i);
+				std::mt19937 gen(seed);
+				for (int r = 0;r < 5;r++) check_nth_element(values,gen() % n);
+			}
+		}
+	}
+
+	void test_sorted_inputs()
+	{
+		std::vector<keyed> ascending;
+		std::vector<keyed> descending;
+		for (int i = 0;i < 3000;i++)
+		{
+			ascending.push_back(keyed(i,i));
+			descending.push_back(keyed(2999 - i,i));
+		}
+		for (const std::vector<keyed>* v : {&ascending,&descending})
+		{
+			check_partial_sort(*v,100);
+			check_nth_element(*v,1500);
+			check_nth_element(*v,0);
+			check_nth_element(*v,2999);
+		}
+	}
+
+	void test_edges()
+	{
+		klist empty;
+		empty.partial_sort(3);
+		CHECK(empty.empty());
+		CHECK_THROWS(empty.nth_element(0),std::out_of_range);
+
+		std::circular_list<int> l = {5,3,9,1,7};
+		CHECK_THROWS(l.nth_element(5),std::out_of_range);
+		CHECK(l.to_vector() == std::vector<int>({5,3,9,1,7}));
+		CHECK(*l.nth_element(4,std::greater<int>()) == 1);
+		l.partial_sort(2,std::greater<int>());
+		std::vector<int> v = l.to_vector();
+		CHECK(v[0] == 9 && v[1] == 7);
+		CHECK(*l.nth_element(2) == 5);
+		l.partial_sort(5);
+		CHECK(l.to_vector() == std::vector<int>({1,3,5,7,9}));
+		l.push_back(0);
+		CHECK(l.back() == 0);
+	}
+
+	void test_move_only()
+	{
+		std::circular_list<std::unique_ptr<int> > l;
+		for (int i = 0;i < 200;i++) l.push_back(std::make_unique<int>((i * 73) % 200));
+		auto less = [](const std::unique_ptr<int>& a,const std::unique_ptr<int>& b) {return *a < *b;};
+		CHECK(**l.nth_element(100,less) == 100);
+		l.partial_sort(10,less);
+		std::circular_list<std::unique_ptr<int> >::iterator it = l.begin();
+		for (int i = 0;i < 10;i++,++it) CHECK(**it == i);
+	}
+}
+
+int main()
+{
+	test_against_std();
+	test_sorted_inputs();
+	test_edges();
+	test_move_only();
+	return 0;
+}
@@ -0,0 +1,83 @@
+#include <circular_list>
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "check.h"
+
+// circular_list::sort on inputs that take each path: runs already in order,
+// strictly descending runs, and large shuffled lists that go parallel when the
+// machine has more than one hardware thread. Built a second time with
+// _CIRCULAR_LIST_PARALLEL_SORT=0, where <future> must not be pulled in.
+
+#if defined(__GLIBCXX__) && !_CIRCULAR_LIST_PARALLEL_SORT && defined(_GLIBCXX_FUTURE)
+#error "<future> included although _CIRCULAR_LIST_PARALLEL_SORT is 0"
+#endif
+
+namespace
+{
+	typedef std::pair<int,int> keyed;
+
+	bool by_key(const keyed& a,const keyed& b) {return a.first < b.first;}
+
+	void check_sort(std::vector<keyed> values)
+	{
+		std::circular_list<keyed> l(values.begin(),values.end());
+		l.sort(by_key);
+		std::stable_sort(values.begin(),values.end(),by_key);
+		CHECK(l.size() == values.size());
+		CHECK(l.to_vector() == values);
+		if (!values.empty())
+		{
+			CHECK(l.front() == values.front());
+			CHECK(l.back() == values.back());
+		}
+	}
+
+	std::vector<keyed> make(size_t n,int keys,unsigned seed)
+	{
+		std::mt19937 gen(seed);
+		std::vector<keyed> v;
+		for (size_t i = 0;i < n;i++) v.push_back(keyed(static_cast<int>(gen() % keys),static_cast<int>(i)));
+		return v;
+	}
+
+	void test_small()
+	{
+		check_sort(std::vector<keyed>());
+		check_sort(make(1,10,1));
+		check_sort(make(2,10,2));
+		for (unsigned seed = 0;seed < 50;seed++) check_sort(make(seed * 7,5,seed));
+	}
+
+	void test_runs()
+	{
+		std::vector<keyed> ascending;
+		std::vector<keyed> descending;
+		std::vector<keyed> sawtooth;
+		for (int i = 0;i < 50000;i++)
+		{
+			ascending.push_back(keyed(i / 3,i));
+			descending.push_back(keyed(50000 - i,i));
+			sawtooth.push_back(keyed(i % 1000,i));
+		}
+		check_sort(ascending);
+		check_sort(descending);
+		check_sort(sawtooth);
+	}
+
+	void test_large()
+	{
+		check_sort(make(std::circular_list<int>::parallel_sort_threshold + 12345,1000,3));
+		check_sort(make(std::circular_list<int>::parallel_sort_threshold * 2,7,4));
+	}
+}
+
+int main()
+{
+	test_small();
+	test_runs();
+	test_large();
+	return 0;
+}
@@ -0,0 +1,195 @@
+#include <circular_list>
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "check.h"
+
+// circular_list range splice, split and merge: empty ranges, whole lists,
+// splicing within one list, and that nodes move rather than being copied.
+
+namespace
+{
+	typedef std::circular_list<int> clist;
+
+	clist range(int from,int to)
+	{
+		clist l;
+		for (int i = from;i < to;i++) l.push_back(i);
+		return l;
+	}
+
+	// Addresses of the elements, to check that nodes were relinked, not
+	// rebuilt. Counted, since the list's iterators wrap past the end.
+	std::vector<const int*> addresses(clist& l)
+	{
+		std::vector<const int*> out;
+		clist::iterator it = l.begin();
+		for (size_t i = 0;i < l.size();i++,++it) out.push_back(&*it);
+		return out;
+	}
+
+	void test_splice_ranges()
+	{
+		clist a = range(0,5);
+		clist b = range(10,15);
+		// Empty ranges move nothing.
+		a.splice(a.begin(),b,b.begin(),b.begin());
+		a.splice(a.end(),b,std::next(b.begin(),2),std::next(b.begin(),2),0);
+		a.splice(a.end(),b,b.end(),b.end());
+		CHECK(a.size() == 5);
+		CHECK(b.size() == 5);
+
+		clist empty;
+		a.splice(a.begin(),empty);
+		a.splice(a.begin(),empty,empty.begin(),empty.end());
+		CHECK(a.to_vector() == std::vector<int>({0,1,2,3,4}));
+
+		// A middle range, with and without the count.
+		std::vector<const int*> moved = {&*std::next(b.begin(),1),&*std::next(b.begin(),2)};
+		a.splice(std::next(a.begin(),2),b,std::next(b.begin(),1),std::next(b.begin(),3));
+		CHECK(a.to_vector() == std::vector<int>({0,1,11,12,2,3,4}));
+		CHECK(b.to_vector() == std::vector<int>({10,13,14}));
+		CHECK(&*std::next(a.begin(),2) == moved[0]);
+		CHECK(&*std::next(a.begin(),3) == moved[1]);
+		a.splice(a.end(),b,b.begin(),std::next(b.begin(),2),2);
+		CHECK(a.to_vector() == std::vector<int>({0,1,11,12,2,3,4,10,13}));
+		CHECK(b.to_vector() == std::vector<int>({14}));
+		CHECK(a.size() == 9);
+		CHECK(b.size() == 1);
+
+		// The whole of another list, as a range and then as a list.
+		clist c = range(20,23);
+		std::vector<const int*> whole = addresses(c);
+		b.splice(b.begin(),c,c.begin(),c.end());
+		CHECK(c.empty());
+		CHECK(b.to_vector() == std::vector<int>({20,21,22,14}));
+		std::vector<const int*> got = addresses(b);
+		CHECK(std::equal(whole.begin(),whole.end(),got.begin()));
+		a.splice(a.begin(),b);
+		CHECK(b.empty());
+		CHECK(a.size() == 13);
+		CHECK(a.front() == 20);
+		b.push_back(1);
+		c.push_back(2);
+		CHECK(b.size() == 1 && c.size() == 1);
+	}
+
+	void test_self_splice()
+	{
+		clist l = range(0,8);
+		std::vector<const int*> before = addresses(l);
+		// Within one list: a range to the front, to the back, and back again.
+		l.splice(l.begin(),l,std::next(l.begin(),5),l.end());
+		CHECK(l.to_vector() == std::vector<int>({5,6,7,0,1,2,3,4}));
+		l.splice(l.end(),l,l.begin(),std::next(l.begin(),3));
+		CHECK(l.to_vector() == std::vector<int>({0,1,2,3,4,5,6,7}));
+		CHECK(addresses(l) == before);
+		l.splice(std::next(l.begin(),6),l,std::next(l.begin(),1),std::next(l.begin(),3),2);
+		CHECK(l.to_vector() == std::vector<int>({0,3,4,5,1,2,6,7}));
+		CHECK(l.size() == 8);
+
+		// Destinations at either end of the range leave the order alone.
+		l.splice(std::next(l.begin(),2),l,std::next(l.begin(),2),std::next(l.begin(),4));
+		l.splice(std::next(l.begin(),4),l,std::next(l.begin(),2),std::next(l.begin(),4));
+		CHECK(l.to_vector() == std::vector<int>({0,3,4,5,1,2,6,7}));
+		l.splice(l.begin(),l,l.begin(),l.end());
+		CHECK(l.to_vector() == std::vector<int>({0,3,4,5,1,2,6,7}));
+
+		// Single elements, including onto themselves and their successor.
+		l.splice(l.end(),l,l.begin());
+		CHECK(l.back() == 0);
+		l.splice(l.begin(),l,l.begin());
+		l.splice(std::next(l.begin(),2),l,std::next(l.begin(),1));
+		CHECK(l.to_vector() == std::vector<int>({3,4,5,1,2,6,7,0}));
+		l.splice(l.end(),l);
+		CHECK(l.size() == 8);
+	}
+
+	void test_split()
+	{
+		clist l = range(0,10);
+		std::vector<const int*> before = addresses(l);
+		clist none = l.split(std::next(l.begin(),3),std::next(l.begin(),3));
+		CHECK(none.empty());
+		CHECK(l.split(l.end(),l.end()).empty());
+		CHECK(l.size() == 10);
+
+		clist mid = l.split(std::next(l.begin(),3),std::next(l.begin(),6));
+		CHECK(mid.to_vector() == std::vector<int>({3,4,5}));
+		CHECK(l.to_vector() == std::vector<int>({0,1,2,6,7,8,9}));
+		CHECK(&mid.front() == before[3]);
+		CHECK(&mid.back() == before[5]);
+
+		clist tail = l.split(std::next(l.begin(),5),l.end());
+		CHECK(tail.to_vector() == std::vector<int>({8,9}));
+		clist all = l.split(l.begin(),l.end());
+		CHECK(all.to_vector() == std::vector<int>({0,1,2,6,7}));
+		CHECK(l.empty());
+		CHECK(l.size() == 0);
+		CHECK(&all.front() == before[0]);
+
+		// Everything still links up after the pieces are put back.
+		l.push_back(-1);
+		all.splice(all.end(),mid);
+		all.splice(all.end(),tail);
+		all.merge(l);
+		CHECK(all.size() == 11);
+		all.sort();
+		CHECK(all.front() == -1);
+		CHECK(all.back() == 9);
+	}
+
+	void test_merge()
+	{
+		clist a = {1,3,5,7};
+		clist b = {0,2,3,8,9};
+		std::vector<const int*> from_b = addresses(b);
+		a.merge(b);
+		CHECK(a.to_vector() == std::vector<int>({0,1,2,3,3,5,7,8,9}));
+		CHECK(b.empty());
+		CHECK(&a.front() == from_b[0]);
+		CHECK(&a.back() == from_b[4]);
+
+		clist empty;
+		a.merge(empty);
+		CHECK(a.size() == 9);
+		empty.merge(a);
+		CHECK(a.empty());
+		CHECK(empty.size() == 9);
+		empty.merge(empty);
+		CHECK(empty.size() == 9);
+
+		// Equal keys keep this list's elements first, each side in order.
+		typedef std::pair<int,char> tagged;
+		auto by_key = [](const tagged& x,const tagged& y) {return x.first < y.first;};
+		std::mt19937 gen(2);
+		std::vector<tagged> xs;
+		std::vector<tagged> ys;
+		for (int i = 0;i < 2000;i++) xs.push_back(tagged(static_cast<int>(gen() % 100),'x'));
+		for (int i = 0;i < 3000;i++) ys.push_back(tagged(static_cast<int>(gen() % 100),'y'));
+		std::stable_sort(xs.begin(),xs.end(),by_key);
+		std::stable_sort(ys.begin(),ys.end(),by_key);
+		std::circular_list<tagged> x(xs.begin(),xs.end());
+		std::circular_list<tagged> y(ys.begin(),ys.end());
+		x.merge(y,by_key);
+		std::list<tagged> rx(xs.begin(),xs.end());
+		std::list<tagged> ry(ys.begin(),ys.end());
+		rx.merge(ry,by_key);
+		CHECK(x.to_vector() == std::vector<tagged>(rx.begin(),rx.end()));
+		CHECK(x.size() == 5000);
+	}
+}
+
+int main()
+{
+	test_splice_ranges();
+	test_self_splice();
+	test_split();
+	test_merge();
+	return 0;
+}
@@ -0,0 +1,236 @@
+#include <circular_list>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "check.h"
+
+// circular_list and unrolled_circular_list over circular_pool_allocator,
+// in particular that a moved-from container stays usable after the container
+// it was moved into is gone; which resource a default allocator uses; and a
+// copy assignment whose allocator fails part way.
+
+namespace
+{
+	typedef std::circular_list<std::string,std::circular_pool_allocator<std::string> > pool_list;
+
+	void fill(pool_list& l,int n)
+	{
+		for (int i = 0;i < n;i++) l.push_back(std::to_string(i));
+	}
+
+	void test_move_construct_then_reuse_source()
+	{
+		pool_list src;
+		fill(src,100);
+		{
+			pool_list dst(std::move(src));
+			CHECK(dst.size() == 100);
+			CHECK(src.empty());
+		}
+		fill(src,300);
+		CHECK(src.size() == 300);
+		CHECK(src.back() == "299");
+		src.clear();
+		fill(src,10);
+		CHECK(src.front() == "0");
+	}
+
+	void test_move_assign_then_reuse_source()
+	{
+		std::shared_ptr<std::circular_pool_resource> res = std::make_shared<std::circular_pool_resource>(16);
+		std::circular_pool_allocator<std::string> a(res);
+		pool_list src(a);
+		fill(src,50);
+		{
+			pool_list dst(std::circular_pool_allocator<std::string>(std::make_shared<std::circular_pool_resource>(16)));
+			fill(dst,5);
+			dst = std::move(src);
+			CHECK(dst.size() == 50);
+			CHECK(dst.get_allocator() == a);
+		}
+		res.reset();
+		fill(src,200);
+		CHECK(src.size() == 200);
+		pool_list other(std::move(src));
+		src = std::move(other);
+		CHECK(src.size() == 200);
+		CHECK(other.empty());
+		fill(other,3);
+		CHECK(other.size() == 3);
+	}
+
+	void test_default_allocators_share_a_resource()
+	{
+		pool_list a;
+		pool_list b;
+		CHECK(a.get_allocator() == b.get_allocator());
+		CHECK(std::circular_pool_allocator<int>() == std::circular_pool_allocator<double>());
+		fill(a,3);
+		fill(b,3);
+		a.splice(a.end(),b);
+		CHECK(a.size() == 6);
+		b = std::move(a);
+		CHECK(b.size() == 6);
+		CHECK(a.empty());
+	}
+
+	void test_default_resource_is_per_thread()
+	{
+		std::circular_pool_allocator<int> here;
+		std::circular_pool_allocator<int> there(std::make_shared<std::circular_pool_resource>());
+		std::thread t([&there] {there = std::circular_pool_allocator<int>();});
+		t.join();
+		CHECK(here != there);
+		CHECK(here.get_resource() == std::circular_pool_default_resource());
+		CHECK(std::circular_pool_default_resource() != std::circular_pool_shared_resource());
+	}
+
+	void test_shared_resource_across_threads()
+	{
+		std::circular_pool_allocator<std::string> shared(std::circular_pool_shared_resource());
+		std::vector<pool_list> lists;
+		for (int i = 0;i < 4;i++) lists.emplace_back(shared);
+		std::vector<std::thread> threads;
+		for (int i = 0;i < 4;i++)
+		{
+			threads.emplace_back([&lists,i]
+			{
+				for (int round = 0;round < 200;round++)
+				{
+					fill(lists[i],50);
+					while (lists[i].size() > 5) lists[i].pop_front();
+				}
+			});
+		}
+		for (std::thread& t : threads) t.join();
+		// Every list shares one allocator, so nodes move between them freely
+		// and can be freed on another thread.
+		for (int i = 1;i < 4;i++) lists[0].splice(lists[0].end(),lists[i]);
+		CHECK(lists[0].size() == 20);
+		std::thread([&lists] {lists[0].clear();}).join();
+		CHECK(lists[0].empty());
+	}
+
+	// Allocations flaky_allocator grants before it throws; -1 for no limit.
+	// Shared by every rebind.
+	int flaky_fail_after = -1;
+
+	// Propagates on copy assignment, compares by id, and can be told to fail.
+	template <typename _Tp>
+	  struct flaky_allocator
+	{
+		typedef _Tp value_type;
+		typedef std::true_type propagate_on_container_copy_assignment;
+
+		int id;
+
+		explicit flaky_allocator(int i) : id(i) {}
+		template <typename _Up>
+		  flaky_allocator(const flaky_allocator<_Up>& other) : id(other.id) {}
+
+		_Tp* allocate(size_t n)
+		{
+			if (flaky_fail_after == 0) throw std::bad_alloc();
+			if (flaky_fail_after > 0) flaky_fail_after--;
+			return std::allocator<_Tp>().allocate(n);
+		}
+
+		void deallocate(_Tp* p,size_t n) {std::allocator<_Tp>().deallocate(p,n);}
+
+		template <typename _Up>
+		  bool operator==(const flaky_allocator<_Up>& other) const {return id == other.id;}
+		template <typename _Up>
+		  bool operator!=(const flaky_allocator<_Up>& other) const {return id != other.id;}
+	};
+
+	void test_copy_assign_allocation_failure()
+	{
+		typedef std::circular_list<int,flaky_allocator<int> > flaky_list;
+		flaky_list dst(flaky_allocator<int>(1));
+		flaky_list src(flaky_allocator<int>(2));
+		for (int i = 0;i < 5;i++)
+		{
+			dst.push_back(i);
+			src.push_back(10 + i);
+		}
+		// The new sentinel is the first allocation; this list must survive it.
+		flaky_fail_after = 0;
+		CHECK_THROWS(dst = src,std::bad_alloc);
+		flaky_fail_after = -1;
+		CHECK(dst.empty());
+		CHECK(dst.get_allocator().id == 1);
+		dst.push_back(7);
+		CHECK(dst.front() == 7);
+
+		// Failing after the sentinel leaves the new allocator and a partial copy.
+		flaky_fail_after = 3;
+		CHECK_THROWS(dst = src,std::bad_alloc);
+		flaky_fail_after = -1;
+		CHECK(dst.get_allocator().id == 2);
+		dst = src;
+		CHECK(dst.to_vector() == src.to_vector());
+		dst.splice(dst.end(),src);
+		CHECK(dst.size() == 10);
+	}
+
+	void test_moved_allocator_is_usable()
+	{
+		std::circular_pool_allocator<int> a(std::make_shared<std::circular_pool_resource>());
+		std::circular_pool_allocator<int> b(std::move(a));
+		CHECK(a == b);
+		int* p = a.allocate(1);
+		*p = 7;
+		a.deallocate(p,1);
+	}
+
+	void test_churn_and_pmr()
+	{
+		pool_list l;
+		for (int round = 0;round < 50;round++)
+		{
+			fill(l,100);
+			while (l.size() > 10) l.pop_front();
+			l.clear();
+		}
+		CHECK(l.empty());
+
+		std::pmr::unsynchronized_pool_resource upstream;
+		std::circular_list<int,std::pmr::polymorphic_allocator<int> > p(&upstream);
+		for (int i = 0;i < 1000;i++) p.push_back(i);
+		decltype(p) moved(std::move(p));
+		p.push_back(1);
+		CHECK(moved.size() == 1000);
+		CHECK(p.size() == 1);
+	}
+
+	void test_unrolled_moved_from()
+	{
+		typedef std::unrolled_circular_list<int,8,std::circular_pool_allocator<int> > pool_unrolled;
+		pool_unrolled src(std::circular_pool_allocator<int>(std::make_shared<std::circular_pool_resource>()));
+		for (int i = 0;i < 100;i++) src.push_back(i);
+		{
+			pool_unrolled dst(std::move(src));
+			CHECK(dst.size() == 100);
+		}
+		for (int i = 0;i < 100;i++) src.push_back(i);
+		CHECK(src.size() == 100);
+	}
+}
+
+int main()
+{
+	test_move_construct_then_reuse_source();
+	test_move_assign_then_reuse_source();
+	test_default_allocators_share_a_resource();
+	test_default_resource_is_per_thread();
+	test_shared_resource_across_threads();
+	test_copy_assign_allocation_failure();
+	test_moved_allocator_is_usable();
+	test_churn_and_pmr();
+	test_unrolled_moved_from();
+	return 0;
+}
@@ -0,0 +1,164 @@
+#include <circular_queue>
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "check.h"
+
+// The ring-buffer circular_queue: wrap-around, capacity edges, copies, moves,
+// resizing and element lifetimes.
+
+namespace
+{
+	struct tracked
+	{
+		static int live;
+		int value;
+
+		explicit tracked(int v = 0) : value(v) {live++;}
+		tracked(const tracked& other) : value(other.value) {live++;}
+		tracked& operator=(const tracked& other) = default;
+		~tracked() {live--;}
+	};
+
+	int tracked::live = 0;
+
+	template <typename _Queue>
+	  std::vector<int> drain(_Queue& q)
+	{
+		std::vector<int> out;
+		while (!q.isEmpty())
+		{
+			out.push_back(q.front());
+			q.dequeue();
+		}
+		return out;
+	}
+
+	void test_capacity()
+	{
+		CHECK_THROWS(std::circular_queue<int>(0),std::invalid_argument);
+		std::circular_queue<int> q(3);
+		CHECK(q.isEmpty());
+		CHECK(q.getcapacity() == 3);
+		CHECK_THROWS(q.front(),std::runtime_error);
+		CHECK(!q.dequeue());
+		CHECK(q.enqueue(1));
+		CHECK(q.enqueue(2));
+		CHECK(q.enqueue(3));
+		CHECK(q.is_full());
+		CHECK(!q.enqueue(4));
+		CHECK(q.front() == 1);
+		CHECK(q.rear() == 3);
+		CHECK(q.size() == 3);
+	}
+
+	void test_wrap_against_deque()
+	{
+		std::mt19937 gen(11);
+		std::circular_queue<int> q(5);
+		std::deque<int> ref;
+		for (int step = 0;step < 100000;step++)
+		{
+			if (gen() % 2)
+			{
+				int v = static_cast<int>(gen());
+				bool ok = q.enqueue(v);
+				CHECK(ok == (ref.size() < 5));
+				if (ok) ref.push_back(v);
+			}
+			else
+			{
+				CHECK(q.dequeue() == !ref.empty());
+				if (!ref.empty()) ref.pop_front();
+			}
+			CHECK(q.size() == ref.size());
+			if (!ref.empty())
+			{
+				CHECK(q.front() == ref.front());
+				CHECK(q.rear() == ref.back());
+			}
+		}
+	}
+
+	void test_copy_move()
+	{
+		std::circular_queue<std::string> q(4);
+		for (int i = 0;i < 6;i++)
+		{
+			q.enqueue(std::to_string(i));
+			if (i % 2) q.dequeue();
+		}
+		std::circular_queue<std::string> copy(q);
+		CHECK(copy.size() == q.size());
+		CHECK(copy.front() == q.front());
+		std::circular_queue<std::string> moved(std::move(copy));
+		CHECK(moved.front() == q.front());
+		CHECK(moved.rear() == q.rear());
+		std::circular_queue<std::string> assigned(1);
+		assigned = q;
+		CHECK(assigned.getcapacity() == 4);
+		CHECK(assigned.rear() == "5");
+	}
+
+	void test_setcapacity()
+	{
+		std::circular_queue<int> q(4);
+		for (int i = 0;i < 4;i++) q.enqueue(i);
+		q.dequeue();
+		q.enqueue(4);
+		q.setcapacity(10);
+		CHECK(q.getcapacity() == 10);
+		for (int i = 5;i < 8;i++) CHECK(q.enqueue(i));
+		CHECK(drain(q) == std::vector<int>({1,2,3,4,5,6,7}));
+		for (int i = 0;i < 6;i++) q.enqueue(i);
+		q.setcapacity(3);
+		CHECK(q.is_full());
+		CHECK(drain(q) == std::vector<int>({0,1,2}));
+	}
+
+	void test_lifetimes()
+	{
+		{
+			std::circular_queue<tracked> q(8);
+			for (int i = 0;i < 20;i++)
+			{
+				q.enqueue(tracked(i));
+				if (q.size() > 5) q.dequeue();
+			}
+			CHECK(tracked::live == 5);
+			q.setcapacity(2);
+			CHECK(tracked::live == 2);
+		}
+		CHECK(tracked::live == 0);
+	}
+
+	void test_to_circular_list()
+	{
+		std::circular_queue<int> q(4);
+		for (int i = 0;i < 6;i++)
+		{
+			q.enqueue(i);
+			if (q.is_full()) q.dequeue();
+		}
+		std::circular_list<int> copied = q.to_circular_list();
+		CHECK(copied.to_vector() == std::vector<int>({3,4,5}));
+		CHECK(q.size() == 3);
+		std::circular_list<int> moved = std::move(q).to_circular_list();
+		CHECK(moved.to_vector() == std::vector<int>({3,4,5}));
+		CHECK(q.isEmpty());
+	}
+}
+
+int main()
+{
+	test_capacity();
+	test_wrap_against_deque();
+	test_copy_move();
+	test_setcapacity();
+	test_lifetimes();
+	test_to_circular_list();
+	return 0;
+}
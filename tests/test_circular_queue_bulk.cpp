@@ -0,0 +1,199 @@
+#include <circular_list>
+#include <circular_queue>
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "check.h"
+
+// Bulk operations: circular_queue enqueue_n and dequeue_n across the wrap
+// point, and circular_list range insert and erase, including ranges that
+// wrap past the sentinel and an insert that throws part way.
+
+namespace
+{
+	void test_enqueue_dequeue_n()
+	{
+		std::circular_queue<int> q(8);
+		std::vector<int> values = {0,1,2,3,4,5,6,7,8,9,10,11};
+		CHECK(q.enqueue_n(values.begin(),values.begin() + 6) == 6);
+		std::vector<int> out;
+		CHECK(q.dequeue_n(std::back_inserter(out),0) == 0);
+		CHECK(q.dequeue_n(std::back_inserter(out),5) == 5);
+		CHECK(out == std::vector<int>({0,1,2,3,4}));
+		// Seven free slots, reached by wrapping: only seven of the rest fit.
+		CHECK(q.enqueue_n(values.begin() + 6,values.end()) == 6);
+		CHECK(q.enqueue_n(values.begin(),values.end()) == 1);
+		CHECK(q.is_full());
+		CHECK(q.enqueue_n(values.begin(),values.end()) == 0);
+		out.clear();
+		CHECK(q.dequeue_n(std::back_inserter(out),100) == 8);
+		CHECK(out == std::vector<int>({5,6,7,8,9,10,11,0}));
+		CHECK(q.isEmpty());
+		CHECK(q.dequeue_n(std::back_inserter(out),3) == 0);
+
+		// A single-pass source stops at the room left.
+		std::istringstream in("1 2 3 4 5 6 7 8 9 10");
+		std::istream_iterator<int> it(in);
+		CHECK(q.enqueue_n(it,std::istream_iterator<int>()) == 8);
+		int ints[3] = {-1,-1,-1};
+		CHECK(q.dequeue_n(ints,3) == 3);
+		CHECK(ints[0] == 1 && ints[2] == 3);
+		CHECK(q.front() == 4);
+	}
+
+	void test_dequeue_n_moves()
+	{
+		std::circular_queue<std::unique_ptr<int> > q(4);
+		for (int i = 0;i < 3;i++) q.enqueue(std::unique_ptr<int>(new int(i)));
+		std::vector<std::unique_ptr<int> > out;
+		CHECK(q.dequeue_n(std::back_inserter(out),2) == 2);
+		for (int i = 3;i < 6;i++) q.enqueue(std::unique_ptr<int>(new int(i)));
+		CHECK(q.dequeue_n(std::back_inserter(out),10) == 4);
+		CHECK(out.size() == 6);
+		for (int i = 0;i < 6;i++) CHECK(out[i] && *out[i] == i);
+	}
+
+	void test_random_against_model()
+	{
+		std::mt19937 gen(5);
+		std::circular_queue<int> q(16);
+		std::deque<int> model;
+		int next = 0;
+		for (int step = 0;step < 3000;step++)
+		{
+			size_t n = gen() % 12;
+			if (gen() % 2)
+			{
+				std::vector<int> batch;
+				for (size_t i = 0;i < n;i++) batch.push_back(next++);
+				size_t fits = std::min(n,16 - model.size());
+				CHECK(q.enqueue_n(batch.begin(),batch.end()) == fits);
+				model.insert(model.end(),batch.begin(),batch.begin() + static_cast<ptrdiff_t>(fits));
+			}
+			else
+			{
+				std::vector<int> out;
+				size_t got = std::min(n,model.size());
+				CHECK(q.dequeue_n(std::back_inserter(out),n) == got);
+				CHECK(std::equal(out.begin(),out.end(),model.begin()));
+				model.erase(model.begin(),model.begin() + static_cast<ptrdiff_t>(got));
+			}
+			CHECK(q.size() == model.size());
+		}
+	}
+
+	struct fragile
+	{
+		static int live;
+		static int fail_at;
+		int value;
+
+		fragile(int v = 0) : value(v)
+		{
+			if (v == fail_at) throw std::runtime_error("fragile");
+			live++;
+		}
+		fragile(const fragile& other) : fragile(other.value) {}
+		~fragile() {live--;}
+		bool operator==(const fragile& other) const {return value == other.value;}
+	};
+
+	int fragile::live = 0;
+	int fragile::fail_at = -1;
+
+	void test_list_range_insert()
+	{
+		std::circular_list<int> l = {0,1,5};
+		std::vector<int> mid = {2,3,4};
+		std::circular_list<int>::iterator first = l.insert(std::next(l.begin(),2),mid.begin(),mid.end());
+		CHECK(*first == 2);
+		CHECK(l.to_vector() == std::vector<int>({0,1,2,3,4,5}));
+		CHECK(*l.insert(l.end(),2,9) == 9);
+		CHECK(*l.insert(l.begin(),{-2,-1}) == -2);
+		CHECK(l.to_vector() == std::vector<int>({-2,-1,0,1,2,3,4,5,9,9}));
+		CHECK(l.size() == 10);
+		// An empty range inserts nothing and returns pos.
+		CHECK(*l.insert(std::next(l.begin(),3),mid.begin(),mid.begin()) == 1);
+		CHECK(l.size() == 10);
+
+		// A throw part way leaves the list as it was.
+		{
+			std::circular_list<fragile> f;
+			f.push_back(fragile(100));
+			int before = fragile::live;
+			std::vector<int> raw = {1,2,3,4};
+			fragile::fail_at = 3;
+			CHECK_THROWS(f.insert(f.end(),raw.begin(),raw.end()),std::runtime_error);
+			CHECK(f.size() == 1);
+			CHECK(fragile::live == before);
+			fragile::fail_at = -1;
+			f.insert(f.begin(),raw.begin(),raw.end());
+			CHECK(f.size() == 5);
+			CHECK(f.back().value == 100);
+		}
+		CHECK(fragile::live == 0);
+	}
+
+	void test_list_range_erase()
+	{
+		std::circular_list<int> l = {0,1,2,3,4,5,6,7};
+		l.erase(std::next(l.begin(),2),std::next(l.begin(),2));
+		CHECK(l.size() == 8);
+		l.erase(std::next(l.begin(),2),std::next(l.begin(),5));
+		CHECK(l.to_vector() == std::vector<int>({0,1,5,6,7}));
+		l.erase(std::next(l.begin(),3),l.end());
+		CHECK(l.to_vector() == std::vector<int>({0,1,5}));
+		CHECK(l.back() == 5);
+
+		// A range whose start comes after its end wraps past the sentinel.
+		std::circular_list<int> w = {0,1,2,3,4,5,6,7};
+		w.erase(std::next(w.begin(),6),std::next(w.begin(),2));
+		CHECK(w.to_vector() == std::vector<int>({2,3,4,5}));
+		CHECK(w.size() == 4);
+		CHECK(w.front() == 2);
+		CHECK(w.back() == 5);
+		w.erase(w.begin(),w.end());
+		CHECK(w.empty());
+		w.erase(w.begin(),w.end());
+		w.push_back(1);
+		CHECK(w.to_vector() == std::vector<int>({1}));
+
+		// Random ranges against std::list, in order only.
+		std::mt19937 gen(9);
+		for (int round = 0;round < 200;round++)
+		{
+			size_t n = gen() % 20;
+			std::circular_list<int> a;
+			std::list<int> ref;
+			for (size_t i = 0;i < n;i++)
+			{
+				a.push_back(static_cast<int>(i));
+				ref.push_back(static_cast<int>(i));
+			}
+			size_t lo = n ? gen() % n : 0;
+			size_t hi = lo + gen() % (n - lo + 1);
+			std::circular_list<int>::iterator stop = hi == n ? a.end() : std::next(a.begin(),static_cast<ptrdiff_t>(hi));
+			a.erase(std::next(a.begin(),static_cast<ptrdiff_t>(lo)),stop);
+			ref.erase(std::next(ref.begin(),static_cast<ptrdiff_t>(lo)),std::next(ref.begin(),static_cast<ptrdiff_t>(hi)));
+			CHECK(a.to_vector() == std::vector<int>(ref.begin(),ref.end()));
+			CHECK(a.size() == ref.size());
+		}
+	}
+}
+
+int main()
+{
+	test_enqueue_dequeue_n();
+	test_dequeue_n_moves();
+	test_random_against_model();
+	test_list_range_insert();
+	test_list_range_erase();
+	return 0;
+}
@@ -0,0 +1,155 @@
+#include <circular_queue>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include <unistd.h>
+
+#include "check.h"
+
+// circular_queue write_to/read_from: round trips through a pipe and a file
+// with wrapped contents, headers from a later version, and headers that must
+// be rejected without touching the queue, a count too large to size a buffer
+// for in particular.
+
+namespace
+{
+	std::vector<int> contents(const std::circular_queue<int>& q) {return std::vector<int>(q.begin(),q.end());}
+
+	// A queue of cap slots holding from..from+n-1, wrapped around the buffer.
+	std::circular_queue<int> wrapped(size_t cap,int from,int n)
+	{
+		std::circular_queue<int> q(cap);
+		for (size_t i = 0;i < cap - 1;i++) q.enqueue(-1);
+		for (size_t i = 0;i < cap - 1;i++) q.dequeue();
+		for (int i = 0;i < n;i++) q.enqueue(from + i);
+		return q;
+	}
+
+	void test_pipe_round_trip()
+	{
+		int fds[2];
+		CHECK(::pipe(fds) == 0);
+		std::circular_queue<int> src = wrapped(8,100,6);
+		CHECK(src.array_two().second > 0);
+		src.write_to(fds[1]);
+		std::circular_queue<int> empty(4);
+		empty.write_to(fds[1]);
+
+		std::circular_queue<int> dst(2);
+		dst.enqueue(7);
+		dst.read_from(fds[0]);
+		CHECK(contents(dst) == contents(src));
+		CHECK(dst.getcapacity() == 6);
+		CHECK(dst.enqueue(1) == false);
+		dst.read_from(fds[0]);
+		CHECK(dst.isEmpty());
+		CHECK(dst.enqueue(1) && dst.front() == 1);
+		::close(fds[0]);
+		::close(fds[1]);
+	}
+
+	void test_file_round_trip()
+	{
+		std::FILE* f = std::tmpfile();
+		CHECK(f != nullptr);
+		int fd = ::fileno(f);
+		std::circular_queue<int> src = wrapped(1024,0,1000);
+		src.write_to(fd);
+		CHECK(::lseek(fd,0,SEEK_SET) == 0);
+		std::circular_queue<int> dst(2000);
+		dst.read_from(fd);
+		CHECK(dst.getcapacity() == 2000);
+		CHECK(contents(dst) == contents(src));
+		std::fclose(f);
+	}
+
+	// Writes a snapshot of {1,2,3} with hdr patched by edit, then reads it.
+	template <typename _Edit>
+	  void read_patched(std::circular_queue<int>& q,_Edit edit,size_t extra_header = 0)
+	{
+		std::FILE* f = std::tmpfile();
+		CHECK(f != nullptr);
+		int fd = ::fileno(f);
+		std::circular_queue<int> src(4);
+		for (int i = 1;i <= 3;i++) src.enqueue(i);
+		src.write_to(fd);
+		std::vector<char> bytes(sizeof(std::circular_queue_snapshot_header) + 3 * sizeof(int));
+		CHECK(::pread(fd,bytes.data(),bytes.size(),0) == static_cast<ssize_t>(bytes.size()));
+		std::circular_queue_snapshot_header hdr;
+		std::memcpy(&hdr,bytes.data(),sizeof(hdr));
+		edit(hdr);
+		hdr.header_size = static_cast<uint16_t>(hdr.header_size + extra_header);
+		std::vector<char> out(reinterpret_cast<char*>(&hdr),reinterpret_cast<char*>(&hdr) + sizeof(hdr));
+		out.insert(out.end(),extra_header,'x');
+		out.insert(out.end(),bytes.begin() + sizeof(hdr),bytes.end());
+		CHECK(::ftruncate(fd,0) == 0);
+		CHECK(::pwrite(fd,out.data(),out.size(),0) == static_cast<ssize_t>(out.size()));
+		CHECK(::lseek(fd,0,SEEK_SET) == 0);
+		try
+		{
+			q.read_from(fd);
+		}
+		catch (...)
+		{
+			std::fclose(f);
+			throw;
+		}
+		std::fclose(f);
+	}
+
+	void test_headers()
+	{
+		typedef std::circular_queue_snapshot_header header;
+		std::circular_queue<int> q(3);
+		q.enqueue(9);
+
+		// Fields appended by a later writer are skipped.
+		read_patched(q,[](header&) {},100);
+		CHECK(contents(q) == std::vector<int>({1,2,3}));
+		q.enqueue(9);
+		read_patched(q,[](header& h) {h.version = header::file_version + 1;},24);
+		CHECK(contents(q) == std::vector<int>({1,2,3}));
+
+		q.dequeue();
+		CHECK_THROWS(read_patched(q,[](header& h) {h.magic ^= 1;}),std::runtime_error);
+		CHECK_THROWS(read_patched(q,[](header& h) {h.version = 0;}),std::runtime_error);
+		CHECK_THROWS(read_patched(q,[](header& h) {h.header_size = sizeof(header) - 1;}),std::runtime_error);
+		CHECK_THROWS(read_patched(q,[](header& h) {h.elem_size = 8;}),std::runtime_error);
+		CHECK(contents(q) == std::vector<int>({2,3}));
+
+		// count * sizeof(int) would wrap to a small number here.
+		uint64_t wraps = (uint64_t(1) << 62) + 1;
+		CHECK_THROWS(read_patched(q,[wraps](header& h) {h.count = wraps;}),std::runtime_error);
+		CHECK_THROWS(read_patched(q,[](header& h) {h.count = std::numeric_limits<uint64_t>::max();}),std::runtime_error);
+		uint64_t just_over = uint64_t(q.max_size()) + 1;
+		CHECK_THROWS(read_patched(q,[just_over](header& h) {h.count = just_over;}),std::runtime_error);
+		CHECK(contents(q) == std::vector<int>({2,3}));
+		CHECK(q.getcapacity() == 3);
+
+		// A count the header allows but the stream does not hold.
+		CHECK_THROWS(read_patched(q,[](header& h) {h.count = 4;}),std::runtime_error);
+		CHECK(q.isEmpty());
+		CHECK(q.enqueue(5) && q.front() == 5);
+	}
+
+	void test_max_size()
+	{
+		std::circular_queue<int> q(1);
+		size_t m = q.max_size();
+		CHECK(m > 0 && (m & (m - 1)) == 0);
+		CHECK(m <= std::numeric_limits<size_t>::max() / sizeof(int));
+		CHECK(std::circular_queue<char>(1).max_size() >= m);
+	}
+}
+
+int main()
+{
+	test_pipe_round_trip();
+	test_file_round_trip();
+	test_headers();
+	test_max_size();
+	return 0;
+}
@@ -0,0 +1,154 @@
+#include <circular_queue>
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "check.h"
+
+// circular_queue in overwrite_oldest mode: dropped(), iteration over a
+// wrapped window, and enqueueing a copy of an element the queue is about to
+// drop.
+
+namespace
+{
+	struct throws_on
+	{
+		static int trigger;
+		int value;
+
+		explicit throws_on(int v) : value(v) {if (v == trigger) throw std::runtime_error("construct");}
+		throws_on(const throws_on& other) : value(other.value) {if (value == trigger) throw std::runtime_error("copy");}
+		throws_on& operator=(const throws_on&) = default;
+	};
+
+	int throws_on::trigger = -1;
+
+	template <typename _Queue>
+	  std::vector<typename _Queue::value_type> window(const _Queue& q)
+	{
+		return std::vector<typename _Queue::value_type>(q.begin(),q.end());
+	}
+
+	void test_against_deque()
+	{
+		// 8 fills the ring exactly; 5 leaves spare slots, so both ways of
+		// replacing the oldest element are exercised.
+		for (size_t cap : {5,8})
+		{
+			std::mt19937 gen(static_cast<unsigned>(cap));
+			std::circular_queue<int> q(cap,std::circular_overflow::overwrite_oldest);
+			std::deque<int> ref;
+			size_t dropped = 0;
+			for (int step = 0;step < 50000;step++)
+			{
+				if (gen() % 3)
+				{
+					int v = static_cast<int>(gen() % 1000);
+					CHECK(q.enqueue(v));
+					if (ref.size() == cap)
+					{
+						ref.pop_front();
+						dropped++;
+					}
+					ref.push_back(v);
+				}
+				else
+				{
+					CHECK(q.dequeue() == !ref.empty());
+					if (!ref.empty()) ref.pop_front();
+				}
+				CHECK(q.size() == ref.size());
+				CHECK(q.dropped() == dropped);
+				CHECK(window(q) == std::vector<int>(ref.begin(),ref.end()));
+			}
+		}
+	}
+
+	void test_iteration_after_wrap()
+	{
+		std::circular_queue<int> q(6,std::circular_overflow::overwrite_oldest);
+		for (int i = 0;i < 20;i++) q.enqueue(i);
+		CHECK(q.dropped() == 14);
+		CHECK(q.front() == 14);
+		CHECK(q.rear() == 19);
+		CHECK(window(q) == std::vector<int>({14,15,16,17,18,19}));
+		std::circular_queue<int>::iterator it = q.begin();
+		CHECK(it[5] == 19);
+		CHECK(*(it + 3) == 17);
+		CHECK(q.end() - q.begin() == 6);
+		CHECK(std::vector<int>(q.cbegin(),q.cend()) == window(q));
+		CHECK(std::vector<int>(std::make_reverse_iterator(q.end()),std::make_reverse_iterator(q.begin())) == std::vector<int>({19,18,17,16,15,14}));
+		for (int& v : q) v = -v;
+		q.sort();
+		CHECK(window(q) == std::vector<int>({-19,-18,-17,-16,-15,-14}));
+	}
+
+	void test_enqueue_own_element()
+	{
+		const std::string a(40,'a');
+		const std::string b(40,'b');
+		for (size_t cap : {2,3,4})
+		{
+			std::circular_queue<std::string> q(cap,std::circular_overflow::overwrite_oldest);
+			for (size_t i = 0;i < cap;i++) q.enqueue(i % 2 ? b : a);
+			CHECK(q.is_full());
+			q.enqueue(*q.begin());
+			CHECK(q.rear() == a);
+			CHECK(q.dropped() == 1);
+			q.emplace(*q.begin(),0,10);
+			CHECK(q.rear() == b.substr(0,10));
+			CHECK(q.size() == cap);
+		}
+	}
+
+	void test_throwing_constructor()
+	{
+		for (size_t cap : {3,4})
+		{
+			std::circular_queue<throws_on> q(cap,std::circular_overflow::overwrite_oldest);
+			for (int i = 0;i < 10;i++) q.emplace(i);
+			throws_on::trigger = 99;
+			CHECK_THROWS(q.emplace(99),std::runtime_error);
+			throws_on::trigger = -1;
+			CHECK(q.size() == cap);
+			CHECK(q.dropped() == 10 - cap);
+			CHECK(q.front().value == static_cast<int>(10 - cap));
+			CHECK(q.rear().value == 9);
+		}
+	}
+
+	void test_switch_mode()
+	{
+		std::circular_queue<int> q(3);
+		CHECK(q.overflow_mode() == std::circular_overflow::reject);
+		for (int i = 0;i < 4;i++) q.enqueue(i);
+		CHECK(window(q) == std::vector<int>({0,1,2}));
+		CHECK(q.dropped() == 0);
+		q.set_overflow_mode(std::circular_overflow::overwrite_oldest);
+		CHECK(q.enqueue(3));
+		CHECK(window(q) == std::vector<int>({1,2,3}));
+		std::vector<int> more = {4,5,6,7};
+		CHECK(q.enqueue_n(more.begin(),more.end()) == 4);
+		CHECK(window(q) == std::vector<int>({5,6,7}));
+		CHECK(q.dropped() == 5);
+		std::circular_queue<int> copy(q);
+		CHECK(copy.dropped() == 5);
+		CHECK(copy.overflow_mode() == std::circular_overflow::overwrite_oldest);
+		q.set_overflow_mode(std::circular_overflow::reject);
+		CHECK(!q.enqueue(8));
+		CHECK(window(q) == std::vector<int>({5,6,7}));
+	}
+}
+
+int main()
+{
+	test_against_deque();
+	test_iteration_after_wrap();
+	test_enqueue_own_element();
+	test_throwing_constructor();
+	test_switch_mode();
+	return 0;
+}
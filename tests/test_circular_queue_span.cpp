@@ -0,0 +1,72 @@
+#include <circular_queue>
+#include <array>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "check.h"
+
+// The C++20 std::span parts of circular_queue: enqueue_n from a span and the
+// two contiguous runs as spans, before and after the contents wrap.
+
+namespace
+{
+	std::vector<int> joined(const std::circular_queue<int>& q)
+	{
+		std::vector<int> out;
+		for (int v : q.span_one()) out.push_back(v);
+		for (int v : q.span_two()) out.push_back(v);
+		return out;
+	}
+
+	void test_enqueue_span()
+	{
+		std::circular_queue<int> q(8);
+		std::array<int,5> a = {0,1,2,3,4};
+		CHECK(q.enqueue_n(std::span<const int>(a)) == 5);
+		std::vector<int> v = {5,6,7,8,9};
+		// A vector converts to the span overload.
+		CHECK(q.enqueue_n(v) == 3);
+		CHECK(q.is_full());
+		CHECK(q.enqueue_n(std::span<const int>()) == 0);
+		CHECK(joined(q) == std::vector<int>({0,1,2,3,4,5,6,7}));
+	}
+
+	void test_runs()
+	{
+		std::circular_queue<int> q(8);
+		CHECK(q.span_one().empty());
+		CHECK(q.span_two().empty());
+		for (int i = 0;i < 6;i++) q.enqueue(i);
+		CHECK(q.span_one().size() == 6);
+		CHECK(q.span_two().empty());
+		for (int i = 0;i < 4;i++) q.dequeue();
+		for (int i = 6;i < 11;i++) q.enqueue(i);
+		// head is slot 4: four elements up to the buffer end, three after.
+		CHECK(q.span_one().size() == 4);
+		CHECK(q.span_two().size() == 3);
+		CHECK(q.span_one().front() == 4);
+		CHECK(q.span_two().back() == 10);
+		CHECK(joined(q) == std::vector<int>({4,5,6,7,8,9,10}));
+		CHECK(q.span_one().data() == q.array_one().first);
+		CHECK(q.span_two().data() == q.array_two().first);
+
+		// Writable through the non-const spans.
+		for (int& v : q.span_two()) v *= 10;
+		CHECK(joined(q) == std::vector<int>({4,5,6,7,80,90,100}));
+
+		std::circular_queue<std::string> s(4);
+		s.enqueue("a");
+		s.enqueue("b");
+		const std::circular_queue<std::string>& cs = s;
+		std::span<const std::string> one = cs.span_one();
+		CHECK(one.size() == 2 && one[1] == "b");
+	}
+}
+
+int main()
+{
+	test_enqueue_span();
+	test_runs();
+	return 0;
+}
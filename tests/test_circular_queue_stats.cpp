@@ -0,0 +1,79 @@
+#include <circular_queue>
+#include <iterator>
+#include <sstream>
+#include <vector>
+
+#include "check.h"
+
+// circular_queue_atomic_stats on circular_queue: what enqueue, enqueue_n and
+// dequeue add to each counter, in particular how rejections are counted for
+// forward and single-pass ranges.
+
+namespace
+{
+	typedef std::circular_queue<int,std::circular_queue_atomic_stats> stats_queue;
+
+	void test_single_ops()
+	{
+		stats_queue q(2);
+		CHECK(q.enqueue(1));
+		CHECK(q.enqueue(2));
+		CHECK(!q.enqueue(3));
+		q.dequeue();
+		CHECK(q.enqueue(4));
+		std::circular_queue_stats s = q.stats();
+		CHECK(s.enqueues == 3);
+		CHECK(s.dequeues == 1);
+		CHECK(s.rejected == 1);
+		CHECK(s.high_water == 2);
+		CHECK(s.allocations == 1);
+	}
+
+	void test_forward_range_counts_each_element()
+	{
+		stats_queue q(4);
+		std::vector<int> values = {1,2,3,4,5,6,7};
+		CHECK(q.enqueue_n(values.begin(),values.end()) == 4);
+		std::circular_queue_stats s = q.stats();
+		CHECK(s.enqueues == 4);
+		CHECK(s.rejected == 3);
+		CHECK(q.enqueue_n(values.begin(),values.begin() + 2) == 0);
+		CHECK(q.stats().rejected == 5);
+	}
+
+	void test_input_range_counts_one_per_call()
+	{
+		stats_queue q(3);
+		std::istringstream in("1 2 3 4 5 6 7 8 9 10");
+		std::istream_iterator<int> first(in),last;
+		CHECK(q.enqueue_n(first,last) == 3);
+		std::circular_queue_stats s = q.stats();
+		CHECK(s.enqueues == 3);
+		CHECK(s.rejected == 1);
+		CHECK(q.front() == 1);
+		CHECK(q.rear() == 3);
+		// The rest of the stream is left for the caller, less the element the
+		// iterator had already read ahead.
+		int next = 0;
+		CHECK(in >> next);
+		CHECK(next == 5);
+	}
+
+	void test_overwrite_counts_no_rejections()
+	{
+		stats_queue q(2,std::circular_overflow::overwrite_oldest);
+		std::vector<int> values = {1,2,3,4,5};
+		CHECK(q.enqueue_n(values.begin(),values.end()) == 5);
+		CHECK(q.stats().rejected == 0);
+		CHECK(q.front() == 4);
+	}
+}
+
+int main()
+{
+	test_single_ops();
+	test_forward_range_counts_each_element();
+	test_input_range_counts_one_per_call();
+	test_overwrite_counts_no_rejections();
+	return 0;
+}
@@ -0,0 +1,156 @@
+#include <concurrent_circular_list>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "check.h"
+
+// concurrent_circular_list: the writer and reader calls, more simultaneous
+// read guards than the registry starts with (in one thread and across
+// threads), nodes erased under open guards staying readable, and readers
+// walking the ring while a writer churns it. Run it under ASan or TSan
+// (CIRCULAR_SANITIZE) to check reclamation.
+
+namespace
+{
+	typedef std::concurrent_circular_list<int> clist;
+	typedef clist::read_guard guard;
+
+	std::vector<int> contents(const clist& l)
+	{
+		std::vector<int> out;
+		l.for_each([&out](int v) {out.push_back(v);});
+		return out;
+	}
+
+	void test_basic()
+	{
+		clist l;
+		CHECK(l.empty());
+		l.push_back(2);
+		l.push_back(4);
+		l.push_front(1);
+		l.insert_before_if([](int v) {return v > 2;},3);
+		l.insert_before_if([](int v) {return v > 100;},5);
+		CHECK(contents(l) == std::vector<int>({1,2,3,4,5}));
+		CHECK(l.size() == 5);
+		CHECK(l.contains(3));
+		int found = 0;
+		CHECK(l.find_if([](int v) {return v % 2 == 0;},found) && found == 2);
+		CHECK(!l.find_if([](int v) {return v > 10;},found));
+		{
+			guard g = l.read();
+			clist::const_iterator last = g.begin();
+			for (int i = 0;i < 4;i++) last = g.next(last);
+			CHECK(*last == 5);
+			CHECK(*g.next(last) == 1);
+		}
+		CHECK(l.remove(3) == 1);
+		CHECK(l.remove_if([](int v) {return v > 3;}) == 2);
+		CHECK(contents(l) == std::vector<int>({1,2}));
+		l.clear();
+		CHECK(l.empty());
+		CHECK(contents(l).empty());
+	}
+
+	void test_nested_guards()
+	{
+		clist l;
+		for (int i = 0;i < 10;i++) l.push_back(i);
+		std::vector<std::unique_ptr<guard> > guards;
+		for (int i = 0;i < 300;i++) guards.emplace_back(new guard(l));
+		clist::const_iterator pinned = guards.front()->begin();
+		l.remove_if([](int v) {return v < 5;});
+		l.collect();
+		// The first guard still holds the erased nodes it can see.
+		int sum = 0;
+		for (clist::const_iterator it = pinned;it != guards.front()->end();++it) sum += *it;
+		CHECK(sum == 45);
+		guards.clear();
+		l.collect();
+		CHECK(contents(l) == std::vector<int>({5,6,7,8,9}));
+
+		// A second list must not be handed the first one's cached slots.
+		clist other;
+		other.push_back(1);
+		guard a(l);
+		guard b(other);
+		CHECK(*a.begin() == 5);
+		CHECK(*b.begin() == 1);
+	}
+
+	// Every thread holds a guard until all of them hold one at the same time.
+	void test_many_readers_at_once()
+	{
+		clist l;
+		l.push_back(7);
+		const int readers = 200;
+		std::atomic<int> holding(0);
+		std::vector<std::thread> threads;
+		for (int i = 0;i < readers;i++)
+		{
+			threads.emplace_back([&l,&holding,readers]
+			{
+				guard g(l);
+				holding++;
+				while (holding.load() < readers) std::this_thread::yield();
+				CHECK(*g.begin() == 7);
+			});
+		}
+		for (std::thread& t : threads) t.join();
+		CHECK(holding == readers);
+	}
+
+	// The ring always holds one run of consecutive values; the writer appends
+	// the next value and drops the oldest, so a reader that finds a gap or a
+	// value outside what the writer has produced read freed or torn memory.
+	void test_stress()
+	{
+		clist l;
+		const int window = 32;
+		for (int i = 0;i < window;i++) l.push_back(i);
+		std::atomic<int> produced(window);
+		std::atomic<bool> done(false);
+		std::vector<std::thread> threads;
+		for (int r = 0;r < 6;r++)
+		{
+			threads.emplace_back([&l,&produced,&done]
+			{
+				while (!done.load(std::memory_order_acquire))
+				{
+					guard g = l.read();
+					int prev = -1;
+					for (clist::const_iterator it = g.begin();it != g.end();++it)
+					{
+						int v = *it;
+						CHECK(v >= 0 && v < produced.load());
+						CHECK(prev < 0 || v > prev);
+						prev = v;
+					}
+				}
+			});
+		}
+		for (int i = window;i < 50000;i++)
+		{
+			produced.store(i + 1);
+			l.push_back(i);
+			l.remove(i - window);
+			if (i % 1000 == 0) std::this_thread::yield();
+		}
+		done.store(true,std::memory_order_release);
+		for (std::thread& t : threads) t.join();
+		CHECK(l.size() == window);
+		l.collect();
+	}
+}
+
+int main()
+{
+	test_basic();
+	test_nested_guards();
+	test_many_readers_at_once();
+	test_stress();
+	return 0;
+}
@@ -0,0 +1,17 @@
+// <circular_list> first: the queue header is then reached from the end of the
+// list header rather than the other way round. Both orders must compile.
+#include <circular_list>
+#include <circular_queue>
+
+#include "check.h"
+
+int main()
+{
+	std::circular_queue<int> q(2);
+	q.enqueue(1);
+	q.enqueue(2);
+	std::circular_list<int> l = q.to_circular_list();
+	CHECK(l.size() == 2);
+	CHECK(l.back() == 2);
+	return 0;
+}
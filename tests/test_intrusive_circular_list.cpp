@@ -0,0 +1,229 @@
+#include <circular_list>
+#include <algorithm>
+#include <list>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "check.h"
+
+// intrusive_circular_list: linking and unlinking caller-owned objects, erase
+// by iterator and by object, splice, moving a list, sort and reverse, and
+// hooks that are not the first member of a type that is not standard layout.
+
+namespace
+{
+	struct base
+	{
+		std::string tag;
+		std::circular_list_hook base_hook;
+	};
+
+	// Not standard layout: a virtual function, and every hook follows other
+	// members. base_list links items through their base subobject.
+	struct item : base
+	{
+		int value;
+		std::circular_list_hook hook;
+		std::circular_list_hook other_hook;
+
+		explicit item(int v = 0) : value(v) {}
+		virtual ~item() {}
+		bool operator<(const item& o) const {return value < o.value;}
+	};
+
+	typedef std::intrusive_circular_list<item,&item::hook> item_list;
+	typedef std::intrusive_circular_list<item,&item::other_hook> other_list;
+	typedef std::intrusive_circular_list<base,&base::base_hook> base_list;
+
+	template <typename _List>
+	  std::vector<int> values(const _List& l)
+	{
+		std::vector<int> out;
+		for (typename _List::const_iterator it = l.begin();it != l.end();++it) out.push_back(it->value);
+		return out;
+	}
+
+	void test_push_pop()
+	{
+		std::vector<item> items;
+		for (int i = 0;i < 6;i++) items.emplace_back(i);
+		item_list l;
+		CHECK(l.empty());
+		CHECK_THROWS(l.front(),std::out_of_range);
+		CHECK_THROWS(l.pop_back(),std::out_of_range);
+		l.push_back(items[2]);
+		l.push_back(items[3]);
+		l.push_front(items[1]);
+		l.insert(l.begin(),items[0]);
+		l.insert(l.end(),items[4]);
+		CHECK(l.size() == 5);
+		CHECK(values(l) == std::vector<int>({0,1,2,3,4}));
+		CHECK(l.front().value == 0);
+		CHECK(l.back().value == 4);
+		const item_list& cl = l;
+		CHECK(cl.front().value == 0);
+		CHECK(cl.back().value == 4);
+		CHECK(cl.last()->value == 4);
+		CHECK(std::distance(cl.cbegin(),cl.cend()) == 5);
+		CHECK(items[3].hook.is_linked());
+		CHECK(!items[5].hook.is_linked());
+
+		l.pop_front();
+		l.pop_back();
+		CHECK(values(l) == std::vector<int>({1,2,3}));
+		CHECK(!items[0].hook.is_linked());
+		CHECK(!items[4].hook.is_linked());
+
+		std::vector<int> backwards;
+		for (item_list::iterator it = l.last();it != l.end();--it) backwards.push_back(it->value);
+		CHECK(backwards == std::vector<int>({3,2,1}));
+		for (item& v : l) v.value *= 10;
+		CHECK(values(l) == std::vector<int>({10,20,30}));
+		l.clear();
+		CHECK(l.empty());
+		CHECK(!items[2].hook.is_linked());
+	}
+
+	void test_erase()
+	{
+		std::vector<item> items;
+		for (int i = 0;i < 5;i++) items.emplace_back(i);
+		item_list l;
+		for (item& v : items) l.push_back(v);
+		item_list::iterator next = l.erase(l.iterator_to(items[1]));
+		CHECK(next->value == 2);
+		l.erase(items[3]);
+		CHECK(values(l) == std::vector<int>({0,2,4}));
+		// Erasing an object that is not linked leaves the list alone.
+		l.erase(items[3]);
+		item loose(9);
+		l.erase(loose);
+		CHECK(l.size() == 3);
+		CHECK(l.erase(l.end()) == l.end());
+		CHECK(l.erase(item_list::iterator()) == l.end());
+		l.erase(items[4]);
+		l.erase(items[0]);
+		l.erase(items[2]);
+		CHECK(l.empty());
+		// An erased object can be linked again.
+		l.push_back(items[2]);
+		CHECK(values(l) == std::vector<int>({2}));
+	}
+
+	void test_two_hooks()
+	{
+		std::vector<item> items;
+		for (int i = 0;i < 4;i++) items.emplace_back(i);
+		item_list a;
+		other_list b;
+		base_list c;
+		for (item& v : items)
+		{
+			a.push_back(v);
+			b.push_front(v);
+			v.tag = std::to_string(v.value);
+			c.push_back(v);
+		}
+		CHECK(values(a) == std::vector<int>({0,1,2,3}));
+		CHECK(values(b) == std::vector<int>({3,2,1,0}));
+		std::string tags;
+		for (const base& v : c) tags += v.tag;
+		CHECK(tags == "0123");
+		a.erase(items[1]);
+		CHECK(values(b) == std::vector<int>({3,2,1,0}));
+		CHECK(&b.back() == &items[0]);
+		CHECK(&c.front() == &items[0]);
+	}
+
+	void test_splice()
+	{
+		std::vector<item> items;
+		for (int i = 0;i < 6;i++) items.emplace_back(i);
+		item_list a;
+		item_list b;
+		for (int i = 0;i < 3;i++) a.push_back(items[i]);
+		for (int i = 3;i < 6;i++) b.push_back(items[i]);
+		a.splice(a.iterator_to(items[1]),b);
+		CHECK(values(a) == std::vector<int>({0,3,4,5,1,2}));
+		CHECK(b.empty());
+		CHECK(a.size() == 6);
+		a.splice(a.end(),b);
+		a.splice(a.begin(),a);
+		CHECK(a.size() == 6);
+		b.splice(b.end(),a);
+		CHECK(values(b) == std::vector<int>({0,3,4,5,1,2}));
+		CHECK(a.empty());
+		CHECK(b.size() == 6);
+	}
+
+	void test_move()
+	{
+		std::vector<item> items;
+		for (int i = 0;i < 4;i++) items.emplace_back(i);
+		item_list a;
+		for (item& v : items) a.push_back(v);
+		item_list b(std::move(a));
+		CHECK(a.empty());
+		CHECK(a.size() == 0);
+		CHECK(values(b) == std::vector<int>({0,1,2,3}));
+		CHECK(&b.front() == &items[0]);
+		// The moved-from list is still usable.
+		item extra(7);
+		a.push_back(extra);
+		CHECK(values(a) == std::vector<int>({7}));
+
+		// Move assignment unlinks what the target held.
+		item spare(8);
+		item_list c;
+		c.push_back(spare);
+		c = std::move(b);
+		CHECK(!spare.hook.is_linked());
+		CHECK(values(c) == std::vector<int>({0,1,2,3}));
+		CHECK(b.empty());
+		{
+			item_list scoped(std::move(c));
+		}
+		for (const item& v : items) CHECK(!v.hook.is_linked());
+	}
+
+	void test_sort_reverse()
+	{
+		std::mt19937 gen(4);
+		std::vector<item> items;
+		for (int i = 0;i < 1000;i++) items.emplace_back(static_cast<int>(gen() % 50));
+		for (int i = 0;i < 1000;i++) items[i].tag = std::to_string(i);
+		item_list l;
+		for (item& v : items) l.push_back(v);
+		l.sort();
+		std::vector<const item*> expect;
+		for (const item& v : items) expect.push_back(&v);
+		std::stable_sort(expect.begin(),expect.end(),[](const item* a,const item* b) {return *a < *b;});
+		std::vector<const item*> got;
+		for (const item& v : l) got.push_back(&v);
+		CHECK(got == expect);
+		l.reverse();
+		std::reverse(expect.begin(),expect.end());
+		got.clear();
+		for (const item& v : l) got.push_back(&v);
+		CHECK(got == expect);
+		l.sort([](const item& a,const item& b) {return a.value > b.value;});
+		got.clear();
+		for (const item& v : l) got.push_back(&v);
+		CHECK(std::is_sorted(got.begin(),got.end(),[](const item* a,const item* b) {return a->value > b->value;}));
+		CHECK(l.size() == 1000);
+	}
+}
+
+int main()
+{
+	test_push_pop();
+	test_erase();
+	test_two_hooks();
+	test_splice();
+	test_move();
+	test_sort_reverse();
+	return 0;
+}
@@ -0,0 +1,190 @@
+#include <mapped_circular_queue>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "check.h"
+
+// mapped_circular_queue: reopening a file, rejecting files that do not match,
+// and recovery after a writer process is killed with SIGKILL part way through
+// its enqueues and dequeues.
+
+namespace
+{
+	// Several words per slot so a torn write shows up as a bad checksum.
+	struct record
+	{
+		uint64_t seq;
+		uint64_t words[6];
+		uint64_t sum;
+	};
+
+	record make_record(uint64_t seq)
+	{
+		record r;
+		r.seq = seq;
+		r.sum = seq;
+		for (int i = 0;i < 6;i++)
+		{
+			r.words[i] = seq * 0x9e3779b97f4a7c15ULL + static_cast<uint64_t>(i);
+			r.sum ^= r.words[i];
+		}
+		return r;
+	}
+
+	bool intact(const record& r)
+	{
+		uint64_t sum = r.seq;
+		for (int i = 0;i < 6;i++) sum ^= r.words[i];
+		return sum == r.sum && r.words[0] == r.seq * 0x9e3779b97f4a7c15ULL;
+	}
+
+	std::string temp_path()
+	{
+		const char* dir = std::getenv("TMPDIR");
+		std::string path = std::string(dir && *dir ? dir : "/tmp") + "/mapped_circular_queue_XXXXXX";
+		int fd = ::mkstemp(&path[0]);
+		CHECK(fd >= 0);
+		::close(fd);
+		return path;
+	}
+
+	void test_reopen()
+	{
+		std::string path = temp_path();
+		{
+			std::mapped_circular_queue<int> q(path,4);
+			CHECK(q.isEmpty());
+			CHECK(q.getcapacity() == 4);
+			CHECK_THROWS(q.front(),std::runtime_error);
+			for (int i = 0;i < 6;i++)
+			{
+				CHECK(q.enqueue(i));
+				if (q.is_full()) q.dequeue();
+			}
+			CHECK(q.dequeue());
+			CHECK(q.enqueue(6));
+			q.flush();
+		}
+		{
+			std::mapped_circular_queue<int> q(path);
+			CHECK(q.getcapacity() == 4);
+			CHECK(q.size() == 3);
+			CHECK(q.front() == 4);
+			CHECK(q.rear() == 6);
+			int v = 0;
+			CHECK(q.dequeue(v) && v == 4);
+		}
+		CHECK_THROWS(std::mapped_circular_queue<int>(path,8),std::invalid_argument);
+		CHECK_THROWS(std::mapped_circular_queue<double>(path,0),std::runtime_error);
+		std::mapped_circular_queue<int> moved(std::mapped_circular_queue<int>(path,4));
+		CHECK(moved.size() == 2);
+		::unlink(path.c_str());
+
+		std::string garbage = temp_path();
+		CHECK_THROWS(std::mapped_circular_queue<int>(garbage,0),std::invalid_argument);
+		::unlink(garbage.c_str());
+		CHECK_THROWS(std::mapped_circular_queue<int>("/nonexistent-dir/queue",4),std::system_error);
+	}
+
+	// Runs in the child: continues the sequence from whatever the file holds,
+	// dropping the oldest record whenever the ring is full, until killed.
+	void writer(const std::string& path,int ready)
+	{
+		std::mapped_circular_queue<record> q(path);
+		uint64_t seq = q.isEmpty() ? 0 : q.rear().seq + 1;
+		bool signalled = false;
+		for (;;seq++)
+		{
+			while (q.is_full())
+			{
+				record r;
+				q.dequeue(r);
+				if (!intact(r)) ::_exit(2);
+			}
+			q.enqueue(make_record(seq));
+			if (!signalled && seq % 512 == 511)
+			{
+				char c = 1;
+				if (::write(ready,&c,1) != 1) ::_exit(3);
+				signalled = true;
+			}
+		}
+	}
+
+	void test_crash_recovery()
+	{
+		std::string path = temp_path();
+		{
+			std::mapped_circular_queue<record> q(path,37);
+		}
+		std::mt19937 gen(21);
+		uint64_t last_seen = 0;
+		for (int round = 0;round < 20;round++)
+		{
+			int fds[2];
+			CHECK(::pipe(fds) == 0);
+			pid_t child = ::fork();
+			CHECK(child >= 0);
+			if (child == 0)
+			{
+				::close(fds[0]);
+				try
+				{
+					writer(path,fds[1]);
+				}
+				catch (...)
+				{
+					::_exit(4);
+				}
+			}
+			::close(fds[1]);
+			char c = 0;
+			CHECK(::read(fds[0],&c,1) == 1);
+			::close(fds[0]);
+			std::this_thread::sleep_for(std::chrono::microseconds(gen() % 5000));
+			CHECK(::kill(child,SIGKILL) == 0);
+			int status = 0;
+			CHECK(::waitpid(child,&status,0) == child);
+			CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGKILL);
+
+			// The reopened queue holds a run of consecutive, untorn records
+			// that continues past everything seen in earlier rounds.
+			std::mapped_circular_queue<record> q(path);
+			CHECK(q.getcapacity() == 37);
+			CHECK(!q.isEmpty());
+			CHECK(q.size() <= 37);
+			uint64_t expect = q.front().seq;
+			size_t n = q.size();
+			for (size_t i = 0;i < n;i++)
+			{
+				record r;
+				CHECK(q.dequeue(r));
+				CHECK(intact(r));
+				CHECK(r.seq == expect++);
+			}
+			CHECK(expect > last_seen);
+			last_seen = expect;
+			// Leave part of the run for the next writer to continue from.
+			for (size_t i = 0;i < n % 5 + 1;i++) CHECK(q.enqueue(make_record(expect - 1 + i)));
+			for (size_t i = 0;i < n % 5;i++) CHECK(q.dequeue());
+			last_seen = q.rear().seq;
+		}
+		::unlink(path.c_str());
+	}
+}
+
+int main()
+{
+	test_reopen();
+	test_crash_recovery();
+	return 0;
+}
@@ -0,0 +1,137 @@
+#include <concurrent_circular_queue>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "check.h"
+
+// mpmc_circular_queue: capacity edges, a throwing copy that must not wedge
+// the ring, and several producers and consumers racing through a small ring.
+
+namespace
+{
+	struct fragile
+	{
+		static bool fail;
+		std::string text;
+
+		explicit fragile(const char* t) : text(t) {}
+		fragile(const fragile& other) : text(other.text) {if (fail) throw std::runtime_error("copy failed");}
+		fragile(fragile&&) noexcept = default;
+		fragile& operator=(const fragile&) = default;
+		fragile& operator=(fragile&&) noexcept = default;
+	};
+
+	bool fragile::fail = false;
+
+	void test_single_thread()
+	{
+		CHECK_THROWS(std::mpmc_circular_queue<int>(0),std::invalid_argument);
+		std::mpmc_circular_queue<int> q(3);
+		CHECK(q.isEmpty());
+		CHECK(q.enqueue(1) && q.enqueue(2) && q.enqueue(3));
+		CHECK(q.is_full());
+		CHECK(!q.try_enqueue(4));
+		int v = 0;
+		CHECK(q.try_dequeue(v) && v == 1);
+		CHECK(q.enqueue(4));
+		CHECK(q.dequeue());
+		CHECK(q.dequeue(v) && v == 3);
+		CHECK(q.dequeue(v) && v == 4);
+		CHECK(!q.dequeue(v));
+		CHECK(q.size() == 0);
+	}
+
+	void test_throwing_copy()
+	{
+		std::mpmc_circular_queue<fragile> q(2);
+		fragile a("a");
+		fragile::fail = true;
+		CHECK_THROWS(q.try_enqueue(a),std::runtime_error);
+		fragile::fail = false;
+		CHECK(q.isEmpty());
+		CHECK(q.try_enqueue(a));
+		q.spin_enqueue(fragile("b"));
+		fragile out("");
+		CHECK(q.try_dequeue(out) && out.text == "a");
+		CHECK(q.try_dequeue(out) && out.text == "b");
+		CHECK(!q.try_dequeue(out));
+	}
+
+	void test_stress()
+	{
+		const unsigned producers = 4;
+		const unsigned consumers = 4;
+		const uint64_t per_producer = 50000;
+		std::mpmc_circular_queue<uint64_t> q(64);
+		std::vector<std::vector<uint64_t> > seen(consumers);
+		std::vector<std::thread> threads;
+		for (unsigned p = 0;p < producers;p++)
+		{
+			threads.emplace_back([&q,p,per_producer]
+			{
+				for (uint64_t i = 0;i < per_producer;i++) q.spin_enqueue((uint64_t(p) << 32) | i);
+			});
+		}
+		for (unsigned c = 0;c < consumers;c++)
+		{
+			threads.emplace_back([&q,&seen,c,per_producer]
+			{
+				for (uint64_t i = 0;i < per_producer;i++)
+				{
+					uint64_t v;
+					q.spin_dequeue(v);
+					seen[c].push_back(v);
+				}
+			});
+		}
+		for (std::thread& t : threads) t.join();
+		CHECK(q.isEmpty());
+
+		// Every value exactly once, and each consumer sees each producer's
+		// values in the order they were sent.
+		std::vector<std::vector<bool> > got(producers,std::vector<bool>(per_producer,false));
+		for (const std::vector<uint64_t>& values : seen)
+		{
+			std::vector<int64_t> last(producers,-1);
+			for (uint64_t v : values)
+			{
+				unsigned p = static_cast<unsigned>(v >> 32);
+				int64_t i = static_cast<int64_t>(v & 0xffffffffu);
+				CHECK(p < producers);
+				CHECK(i > last[p]);
+				last[p] = i;
+				CHECK(!got[p][i]);
+				got[p][i] = true;
+			}
+		}
+		for (const std::vector<bool>& flags : got)
+			for (bool f : flags) CHECK(f);
+	}
+
+	void test_non_power_of_two()
+	{
+		std::mpmc_circular_queue<int> q(5);
+		for (int round = 0;round < 100;round++)
+		{
+			for (int i = 0;i < 5;i++) CHECK(q.enqueue(round * 5 + i));
+			CHECK(!q.enqueue(0));
+			for (int i = 0;i < 5;i++)
+			{
+				int v;
+				CHECK(q.dequeue(v) && v == round * 5 + i);
+			}
+		}
+	}
+}
+
+int main()
+{
+	test_single_thread();
+	test_throwing_copy();
+	test_stress();
+	test_non_power_of_two();
+	return 0;
+}
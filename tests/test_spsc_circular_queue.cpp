@@ -0,0 +1,94 @@
+#include <concurrent_circular_queue>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "check.h"
+
+// spsc_circular_queue: single-threaded edges, then one producer and one
+// consumer racing through a small ring; the consumer must see every value
+// exactly once and in order.
+
+namespace
+{
+	void test_single_thread()
+	{
+		CHECK_THROWS(std::spsc_circular_queue<int>(0),std::invalid_argument);
+		std::spsc_circular_queue<int> q(3);
+		CHECK(q.isEmpty());
+		CHECK_THROWS(q.front(),std::runtime_error);
+		CHECK(q.enqueue(1));
+		CHECK(q.enqueue(2));
+		CHECK(q.enqueue(3));
+		CHECK(q.is_full());
+		CHECK(!q.enqueue(4));
+		CHECK(q.front() == 1);
+		int v = 0;
+		CHECK(q.dequeue(v) && v == 1);
+		CHECK(q.enqueue(4));
+		CHECK(q.dequeue());
+		CHECK(q.dequeue(v) && v == 3);
+		CHECK(q.dequeue(v) && v == 4);
+		CHECK(!q.dequeue(v));
+	}
+
+	void test_stress()
+	{
+		const unsigned long count = 200000;
+		std::spsc_circular_queue<unsigned long> q(64);
+		std::thread producer([&]
+		{
+			for (unsigned long i = 0;i < count;i++)
+			{
+				while (!q.enqueue(i)) std::this_thread::yield();
+			}
+		});
+		unsigned long expected = 0;
+		while (expected < count)
+		{
+			unsigned long v;
+			if (!q.dequeue(v))
+			{
+				std::this_thread::yield();
+				continue;
+			}
+			CHECK(v == expected);
+			expected++;
+		}
+		producer.join();
+		CHECK(q.isEmpty());
+	}
+
+	void test_owned_values()
+	{
+		const int count = 20000;
+		std::shared_ptr<int> token = std::make_shared<int>(0);
+		{
+			std::spsc_circular_queue<std::shared_ptr<int> > q(16);
+			std::thread producer([&]
+			{
+				for (int i = 0;i < count;i++)
+				{
+					while (!q.enqueue(token)) std::this_thread::yield();
+				}
+			});
+			for (int i = 0;i < count - 5;)
+			{
+				std::shared_ptr<int> p;
+				if (q.dequeue(p)) i++;
+				else std::this_thread::yield();
+			}
+			producer.join();
+			CHECK(q.size() == 5);
+		}
+		CHECK(token.use_count() == 1);
+	}
+}
+
+int main()
+{
+	test_single_thread();
+	test_stress();
+	test_owned_values();
+	return 0;
+}
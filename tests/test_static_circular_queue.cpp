@@ -0,0 +1,196 @@
+#include <circular_queue>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "check.h"
+
+// static_circular_queue: use in constant expressions, wrap-around with power
+// of two and other capacities against a model, and copies and moves of
+// queues holding non-trivial and move-only elements.
+
+namespace
+{
+	// Pushes 0..n-1 through a ring of _Nm slots, dequeuing whenever it is
+	// full, and returns the sum of what came out in order, weighted by
+	// position so that an out-of-order ring gives a different answer.
+	template <size_t _Nm>
+	  constexpr long weighted_pass(int n)
+	{
+		std::static_circular_queue<int,_Nm> q;
+		long total = 0;
+		long position = 1;
+		int v = 0;
+		for (int i = 0;i < n;i++)
+		{
+			if (q.is_full())
+			{
+				q.dequeue(v);
+				total += position++ * v;
+			}
+			q.enqueue(i);
+		}
+		while (q.dequeue(v)) total += position++ * v;
+		return total;
+	}
+
+	constexpr long weighted_reference(int n)
+	{
+		long total = 0;
+		for (int i = 0;i < n;i++) total += static_cast<long>(i + 1) * i;
+		return total;
+	}
+
+	static_assert(weighted_pass<4>(19) == weighted_reference(19),"constexpr ring, power of two");
+	static_assert(weighted_pass<5>(23) == weighted_reference(23),"constexpr ring, odd size");
+	static_assert(weighted_pass<1>(3) == weighted_reference(3),"constexpr ring, one slot");
+	static_assert(std::static_circular_queue<int,7>::getcapacity() == 7,"capacity");
+
+	constexpr bool full_rejects()
+	{
+		std::static_circular_queue<int,3> q;
+		bool ok = q.enqueue(1) && q.enqueue(2) && q.enqueue(3);
+		ok = ok && !q.enqueue(4) && q.is_full() && q.size() == 3;
+		ok = ok && q.front() == 1 && q.rear() == 3;
+		ok = ok && q.dequeue() && q.enqueue(4) && q.rear() == 4;
+		q.clear();
+		return ok && q.isEmpty() && !q.dequeue();
+	}
+
+	static_assert(full_rejects(),"constexpr full and empty edges");
+
+	template <size_t _Nm>
+	  void check_against_model(unsigned seed)
+	{
+		std::static_circular_queue<std::string,_Nm> q;
+		std::deque<std::string> model;
+		std::mt19937 gen(seed);
+		int next = 0;
+		for (int step = 0;step < 5000;step++)
+		{
+			if (gen() % 5 < 3)
+			{
+				std::string s = std::to_string(next++) + std::string(20,'.');
+				bool fits = model.size() < _Nm;
+				CHECK(q.enqueue(s) == fits);
+				if (fits) model.push_back(s);
+			}
+			else
+			{
+				std::string out;
+				bool had = !model.empty();
+				CHECK(q.dequeue(out) == had);
+				if (had)
+				{
+					CHECK(out == model.front());
+					model.pop_front();
+				}
+			}
+			CHECK(q.size() == model.size());
+			if (!model.empty())
+			{
+				CHECK(q.front() == model.front());
+				CHECK(q.rear() == model.back());
+			}
+		}
+	}
+
+	void test_wrap_against_model()
+	{
+		check_against_model<8>(1);
+		check_against_model<5>(2);
+		check_against_model<3>(3);
+		check_against_model<1>(4);
+
+		std::static_circular_queue<int,6> q;
+		CHECK_THROWS(q.front(),std::runtime_error);
+		CHECK_THROWS(q.rear(),std::runtime_error);
+		for (int i = 0;i < 6;i++) q.enqueue(i);
+		std::vector<int> out;
+		CHECK(q.dequeue_n(std::back_inserter(out),4) == 4);
+		for (int i = 6;i < 10;i++) CHECK(q.enqueue(i));
+		CHECK(!q.enqueue(10));
+		CHECK(q.dequeue_n(std::back_inserter(out),100) == 6);
+		CHECK(out == std::vector<int>({0,1,2,3,4,5,6,7,8,9}));
+	}
+
+	void test_copy_and_move_strings()
+	{
+		// Fill, then wrap, so the copies start from a head that is not slot 0.
+		std::static_circular_queue<std::string,5> a;
+		for (int i = 0;i < 5;i++) a.enqueue(std::string(30,static_cast<char>('a' + i)));
+		a.dequeue();
+		a.dequeue();
+		a.enqueue(std::string(30,'f'));
+		std::static_circular_queue<std::string,5> b(a);
+		CHECK(b.size() == 4);
+		CHECK(b.front() == std::string(30,'c'));
+		CHECK(b.rear() == std::string(30,'f'));
+		CHECK(a.size() == 4);
+		b.enqueue("g");
+		CHECK(b.is_full());
+		CHECK(!a.is_full());
+
+		std::static_circular_queue<std::string,5> c;
+		c.enqueue("stale");
+		c = b;
+		CHECK(c.size() == 5);
+		CHECK(c.rear() == "g");
+		const std::static_circular_queue<std::string,5>& self = c;
+		c = self;
+		CHECK(c.size() == 5);
+
+		std::static_circular_queue<std::string,5> d(std::move(c));
+		CHECK(d.size() == 5);
+		CHECK(d.front() == std::string(30,'c'));
+		CHECK(c.isEmpty());
+		CHECK(c.enqueue("reused"));
+		CHECK(c.front() == "reused");
+		c = std::move(d);
+		CHECK(c.size() == 5);
+		CHECK(d.isEmpty());
+		std::string out;
+		for (char ch : {'c','d','e','f'})
+		{
+			CHECK(c.dequeue(out));
+			CHECK(out == std::string(30,ch));
+		}
+		CHECK(c.dequeue(out) && out == "g");
+	}
+
+	void test_move_only_elements()
+	{
+		typedef std::static_circular_queue<std::unique_ptr<int>,4> ptr_queue;
+		ptr_queue a;
+		for (int i = 0;i < 4;i++) a.emplace(new int(i));
+		std::unique_ptr<int> out;
+		CHECK(a.dequeue(out) && *out == 0);
+		CHECK(a.enqueue(std::unique_ptr<int>(new int(4))));
+		CHECK(!a.enqueue(std::unique_ptr<int>(new int(5))));
+
+		ptr_queue b(std::move(a));
+		CHECK(a.isEmpty());
+		CHECK(b.size() == 4);
+		ptr_queue c;
+		c.emplace(new int(-1));
+		c = std::move(b);
+		CHECK(b.isEmpty());
+		std::vector<std::unique_ptr<int> > drained;
+		CHECK(c.dequeue_n(std::back_inserter(drained),10) == 4);
+		CHECK(c.isEmpty());
+		for (int i = 0;i < 4;i++) CHECK(*drained[i] == i + 1);
+	}
+}
+
+int main()
+{
+	test_wrap_against_model();
+	test_copy_and_move_strings();
+	test_move_only_elements();
+	return 0;
+}
@@ -0,0 +1,207 @@
+#include <timing_wheel>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "check.h"
+
+// timing_wheel against a brute-force model: random schedules, cancels and
+// advances over deltas that exercise every level and the overflow slot, with
+// fire callbacks that re-arm their own timer and cancel or re-arm others.
+// Also exceptions thrown by fire, and timers outliving their wheel.
+
+namespace
+{
+	const uint64_t unarmed = ~uint64_t(0);
+
+	struct test_timer : std::timing_wheel_timer
+	{
+		size_t id;
+	};
+
+	// Each pending timer fires at exactly max(expires, now() + 1) as seen when
+	// it was scheduled, and no timer fires while an earlier one is pending.
+	struct model
+	{
+		std::vector<uint64_t> due;
+		std::set<std::pair<uint64_t,size_t> > order;
+
+		explicit model(size_t n) : due(n,unarmed) {}
+
+		bool cancel(size_t id)
+		{
+			if (due[id] == unarmed) return false;
+			order.erase(std::make_pair(due[id],id));
+			due[id] = unarmed;
+			return true;
+		}
+
+		void schedule(size_t id,uint64_t expires,uint64_t now)
+		{
+			cancel(id);
+			due[id] = expires > now ? expires : now + 1;
+			order.insert(std::make_pair(due[id],id));
+		}
+
+		uint64_t earliest() const {return order.empty() ? unarmed : order.begin()->first;}
+	};
+
+	uint64_t random_delta(std::mt19937_64& gen)
+	{
+		switch (gen() % 8)
+		{
+			case 0: return 0;
+			case 1: return gen() % 64;
+			case 2: return gen() % 4096;
+			case 3: return gen() % (uint64_t(1) << 18);
+			case 4: return gen() % (uint64_t(1) << 24);
+			case 5: return gen() % (uint64_t(1) << 32);
+			default: return gen() % 200;
+		}
+	}
+
+	void test_against_model(uint64_t start,unsigned seed)
+	{
+		const size_t n = 300;
+		std::mt19937_64 gen(seed);
+		std::timing_wheel wheel(start);
+		std::vector<test_timer> timers(n);
+		for (size_t i = 0;i < n;i++) timers[i].id = i;
+		model ref(n);
+		uint64_t fired_total = 0;
+
+		for (int step = 0;step < 20000;step++)
+		{
+			size_t id = static_cast<size_t>(gen() % n);
+			unsigned op = static_cast<unsigned>(gen() % 10);
+			if (op < 5)
+			{
+				uint64_t delta = random_delta(gen);
+				// Now and then a deadline already in the past.
+				uint64_t expires = gen() % 16 == 0 && wheel.now() > delta ? wheel.now() - delta : wheel.now() + delta;
+				wheel.schedule(timers[id],expires);
+				ref.schedule(id,expires,wheel.now());
+			}
+			else if (op < 7) CHECK(wheel.cancel(timers[id]) == ref.cancel(id));
+			else
+			{
+				uint64_t target = wheel.now() + (gen() % 4 == 0 ? random_delta(gen) : gen() % 100);
+				uint64_t last_tick = wheel.now();
+				size_t fired = wheel.advance(target,[&](std::timing_wheel_timer& base)
+				{
+					test_timer& t = static_cast<test_timer&>(base);
+					uint64_t tick = wheel.now();
+					CHECK(!t.pending());
+					CHECK(!t.hook.is_linked());
+					CHECK(tick >= last_tick && tick <= target);
+					CHECK(ref.due[t.id] == tick);
+					CHECK(ref.earliest() == tick);
+					ref.cancel(t.id);
+					last_tick = tick;
+					CHECK(wheel.size() == ref.order.size());
+					switch (gen() % 6)
+					{
+						case 0:
+						{
+							uint64_t delta = gen() % 3 ? gen() % 100 : random_delta(gen);
+							wheel.schedule(t,tick + delta);
+							ref.schedule(t.id,tick + delta,tick);
+							break;
+						}
+						case 1:
+						{
+							size_t other = static_cast<size_t>(gen() % n);
+							CHECK(wheel.cancel(timers[other]) == ref.cancel(other));
+							break;
+						}
+						case 2:
+						{
+							size_t other = static_cast<size_t>(gen() % n);
+							uint64_t delta = gen() % 100;
+							wheel.schedule(timers[other],tick + delta);
+							ref.schedule(other,tick + delta,tick);
+							break;
+						}
+						default: break;
+					}
+				});
+				fired_total += fired;
+				CHECK(wheel.now() == target);
+				CHECK(ref.earliest() == unarmed || ref.earliest() > target);
+			}
+			CHECK(wheel.size() == ref.order.size());
+			CHECK(wheel.empty() == ref.order.empty());
+			for (size_t probe = 0;probe < 3;probe++)
+			{
+				size_t i = static_cast<size_t>(gen() % n);
+				CHECK(timers[i].pending() == (ref.due[i] != unarmed));
+			}
+		}
+		CHECK(fired_total > 1000);
+
+		// Drain everything, the overflow slot included.
+		wheel.advance(wheel.now() + (uint64_t(1) << 33),[&](std::timing_wheel_timer& base)
+		{
+			test_timer& t = static_cast<test_timer&>(base);
+			CHECK(ref.due[t.id] == wheel.now());
+			CHECK(ref.earliest() == wheel.now());
+			ref.cancel(t.id);
+		});
+		CHECK(wheel.empty());
+		CHECK(ref.order.empty());
+	}
+
+	void test_fire_throws()
+	{
+		std::timing_wheel wheel;
+		std::vector<test_timer> timers(5);
+		for (size_t i = 0;i < timers.size();i++)
+		{
+			timers[i].id = i;
+			wheel.schedule(timers[i],10);
+		}
+		wheel.schedule(timers[4],20);
+		size_t calls = 0;
+		CHECK_THROWS(wheel.advance(30,[&calls](std::timing_wheel_timer&)
+		{
+			if (++calls == 2) throw std::runtime_error("fire");
+		}),std::runtime_error);
+		CHECK(wheel.size() == 3);
+		std::vector<uint64_t> ticks;
+		CHECK(wheel.advance(30,[&](std::timing_wheel_timer&) {ticks.push_back(wheel.now());}) == 3);
+		CHECK(ticks == std::vector<uint64_t>({10,10,20}));
+		CHECK(wheel.now() == 30);
+		CHECK(wheel.empty());
+	}
+
+	void test_timers_outlive_wheel()
+	{
+		std::vector<test_timer> timers(100);
+		{
+			std::timing_wheel wheel;
+			for (size_t i = 0;i < timers.size();i++) wheel.schedule(timers[i],i * 1000);
+			CHECK(wheel.size() == 100);
+		}
+		for (test_timer& t : timers)
+		{
+			CHECK(!t.pending());
+			CHECK(!t.hook.is_linked());
+		}
+		std::timing_wheel wheel;
+		for (test_timer& t : timers) wheel.schedule(t,5);
+		CHECK(wheel.advance(5,[](std::timing_wheel_timer&) {}) == 100);
+	}
+}
+
+int main()
+{
+	test_against_model(0,1);
+	test_against_model(uint64_t(1) << 40,2);
+	test_against_model((uint64_t(1) << 30) - 37,3);
+	test_fire_throws();
+	test_timers_outlive_wheel();
+	return 0;
+}
@@ -0,0 +1,191 @@
+#include <circular_list>
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "check.h"
+
+// unrolled_circular_list against std::list under random edits, and its sort:
+// stability, move-only payloads, the fallback for throwing moves, and a
+// throwing comparator.
+
+namespace
+{
+	typedef std::unrolled_circular_list<int,8> small_list;
+
+	std::vector<int> contents(const std::list<int>& l) {return std::vector<int>(l.begin(),l.end());}
+
+	void test_random_ops()
+	{
+		std::mt19937 gen(5);
+		small_list l;
+		std::list<int> ref;
+		for (int step = 0;step < 30000;step++)
+		{
+			int v = static_cast<int>(gen() % 100);
+			switch (gen() % 9)
+			{
+				case 0: l.push_back(v);ref.push_back(v);break;
+				case 1: l.push_front(v);ref.push_front(v);break;
+				case 2:
+				{
+					size_t at = gen() % (ref.size() + 1);
+					l.insert(std::next(l.begin(),static_cast<ptrdiff_t>(at)),v);
+					ref.insert(std::next(ref.begin(),static_cast<ptrdiff_t>(at)),v);
+					break;
+				}
+				case 3:
+					if (!ref.empty())
+					{
+						size_t at = gen() % ref.size();
+						l.erase(std::next(l.begin(),static_cast<ptrdiff_t>(at)));
+						ref.erase(std::next(ref.begin(),static_cast<ptrdiff_t>(at)));
+					}
+					break;
+				case 4:
+					if (!ref.empty())
+					{
+						size_t at = gen() % ref.size();
+						CHECK(l[static_cast<int>(at)] == *std::next(ref.begin(),static_cast<ptrdiff_t>(at)));
+					}
+					break;
+				case 5:
+					if (gen() % 50 == 0)
+					{
+						l.remove(v);
+						ref.remove(v);
+					}
+					break;
+				case 6:
+					if (gen() % 50 == 0)
+					{
+						l.unique();
+						ref.unique();
+					}
+					break;
+				case 7:
+					if (gen() % 50 == 0)
+					{
+						l.reverse();
+						ref.reverse();
+					}
+					break;
+				default:
+					if (gen() % 100 == 0)
+					{
+						l.sort();
+						ref.sort();
+					}
+					break;
+			}
+			CHECK(l.size() == ref.size());
+		}
+		CHECK(l.to_vector() == contents(ref));
+		CHECK(std::vector<int>(l.begin(),l.end()) == contents(ref));
+	}
+
+	void test_sort_stable()
+	{
+		std::mt19937 gen(9);
+		for (size_t n : {0,1,7,8,9,100,1000,20000})
+		{
+			std::vector<std::pair<int,int> > values;
+			for (size_t i = 0;i < n;i++) values.push_back(std::make_pair(static_cast<int>(gen() % 37),static_cast<int>(i)));
+			std::unrolled_circular_list<std::pair<int,int>,16> l;
+			for (auto& v : values)
+			{
+				if (gen() % 3) l.push_back(v);
+				else l.insert(l.end(),v);
+			}
+			// Thin some chunks out so the merge sees ragged input.
+			for (size_t i = 0;i < n / 10;i++) l.erase(std::next(l.begin(),static_cast<ptrdiff_t>(gen() % l.size())));
+			std::vector<std::pair<int,int> > expect = l.to_vector();
+			auto by_key = [](const std::pair<int,int>& a,const std::pair<int,int>& b) {return a.first < b.first;};
+			l.sort(by_key);
+			std::stable_sort(expect.begin(),expect.end(),by_key);
+			CHECK(l.to_vector() == expect);
+			CHECK(l.size() == expect.size());
+			if (!expect.empty())
+			{
+				CHECK(l.back() == expect.back());
+				CHECK(*std::prev(l.end()) == expect.back());
+			}
+		}
+	}
+
+	void test_sort_move_only()
+	{
+		std::unrolled_circular_list<std::unique_ptr<int>,4> l;
+		for (int i = 0;i < 100;i++) l.push_back(std::make_unique<int>((i * 37) % 100));
+		l.sort([](const std::unique_ptr<int>& a,const std::unique_ptr<int>& b) {return *a < *b;});
+		int expect = 0;
+		for (auto& p : l) CHECK(*p == expect++);
+	}
+
+	struct throwing_move
+	{
+		int value;
+
+		explicit throwing_move(int v) : value(v) {}
+		throwing_move(const throwing_move& other) : value(other.value) {}
+		throwing_move(throwing_move&& other) noexcept(false) : value(other.value) {}
+		throwing_move& operator=(const throwing_move&) = default;
+		bool operator<(const throwing_move& other) const {return value < other.value;}
+	};
+
+	void test_sort_fallback()
+	{
+		std::unrolled_circular_list<throwing_move,4> l;
+		std::vector<int> expect;
+		for (int i = 0;i < 500;i++)
+		{
+			l.push_back(throwing_move((i * 7919) % 1000));
+			expect.push_back((i * 7919) % 1000);
+		}
+		l.sort();
+		std::sort(expect.begin(),expect.end());
+		std::vector<int> got;
+		for (auto& v : l) got.push_back(v.value);
+		CHECK(got == expect);
+	}
+
+	void test_sort_throwing_comparator()
+	{
+		std::unrolled_circular_list<std::string,4> l;
+		std::vector<std::string> expect;
+		for (int i = 0;i < 200;i++)
+		{
+			l.push_back(std::to_string((i * 31) % 200));
+			expect.push_back(std::to_string((i * 31) % 200));
+		}
+		int calls = 0;
+		CHECK_THROWS(l.sort([&calls](const std::string& a,const std::string& b)
+		{
+			if (++calls == 700) throw std::runtime_error("comparator");
+			return a < b;
+		}),std::runtime_error);
+		CHECK(l.size() == expect.size());
+		std::vector<std::string> got = l.to_vector();
+		std::sort(got.begin(),got.end());
+		std::sort(expect.begin(),expect.end());
+		CHECK(got == expect);
+		l.sort();
+		CHECK(l.to_vector() == expect);
+	}
+}
+
+int main()
+{
+	test_random_ops();
+	test_sort_stable();
+	test_sort_move_only();
+	test_sort_fallback();
+	test_sort_throwing_comparator();
+	return 0;
+}
@@ -0,0 +1,133 @@
+#include <circular_queue>
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include "check.h"
+
+// windowed_circular_queue against a brute-force fold of a model deque: sum,
+// min, max and a non-commutative monoid, in reject and overwrite modes.
+
+namespace
+{
+	// String concatenation: associative but not commutative, so any fold
+	// that takes its operands out of order shows up as a wrong string.
+	struct concat
+	{
+		static std::string identity() {return std::string();}
+		std::string operator()(const std::string& a,const std::string& b) const {return a + b;}
+	};
+
+	template <typename _Tp,typename _Monoid>
+	  _Tp brute_fold(const std::deque<_Tp>& model)
+	{
+		_Monoid op;
+		_Tp acc = _Monoid::identity();
+		for (const _Tp& v : model) acc = op(acc,v);
+		return acc;
+	}
+
+	template <typename _Tp,typename _Monoid,typename _Gen>
+	  void check_against_model(size_t cap,std::circular_overflow mode,_Gen sample,unsigned seed)
+	{
+		std::windowed_circular_queue<_Tp,_Monoid> q(cap,mode);
+		std::deque<_Tp> model;
+		size_t dropped = 0;
+		std::mt19937 gen(seed);
+		CHECK(q.aggregate() == _Monoid::identity());
+		for (int step = 0;step < 4000;step++)
+		{
+			unsigned op = static_cast<unsigned>(gen() % 10);
+			if (op < 6)
+			{
+				_Tp v = sample(gen);
+				bool full = model.size() == cap;
+				bool taken = !full || mode == std::circular_overflow::overwrite_oldest;
+				CHECK(q.enqueue(v) == taken);
+				if (full && taken)
+				{
+					model.pop_front();
+					dropped++;
+				}
+				if (taken) model.push_back(v);
+			}
+			else if (op < 9)
+			{
+				CHECK(q.dequeue() == !model.empty());
+				if (!model.empty()) model.pop_front();
+			}
+			else if (gen() % 20 == 0)
+			{
+				q.clear();
+				model.clear();
+			}
+			CHECK(q.size() == model.size());
+			CHECK(q.is_full() == (model.size() == cap));
+			CHECK(q.dropped() == dropped);
+			CHECK(q.aggregate() == (brute_fold<_Tp,_Monoid>(model)));
+			if (!model.empty())
+			{
+				CHECK(q.front() == model.front());
+				CHECK(q.rear() == model.back());
+			}
+		}
+	}
+
+	int small_int(std::mt19937& gen) {return static_cast<int>(gen() % 2001) - 1000;}
+
+	std::string short_word(std::mt19937& gen)
+	{
+		std::string s(1 + gen() % 3,'a');
+		for (char& ch : s) ch = static_cast<char>('a' + gen() % 26);
+		return s;
+	}
+
+	void test_models()
+	{
+		for (std::circular_overflow mode : {std::circular_overflow::reject,std::circular_overflow::overwrite_oldest})
+		{
+			for (size_t cap : {1,2,5,8,13})
+			{
+				unsigned seed = static_cast<unsigned>(cap * 2 + (mode == std::circular_overflow::reject));
+				check_against_model<int,std::circular_sum<int> >(cap,mode,small_int,seed);
+				check_against_model<int,std::circular_min<int> >(cap,mode,small_int,seed + 100);
+				check_against_model<int,std::circular_max<int> >(cap,mode,small_int,seed + 200);
+				check_against_model<std::string,concat>(cap,mode,short_word,seed + 300);
+			}
+		}
+	}
+
+	void test_sliding_window()
+	{
+		std::windowed_circular_queue<std::string,concat> w(3,std::circular_overflow::overwrite_oldest);
+		CHECK_THROWS(w.front(),std::runtime_error);
+		CHECK(w.aggregate().empty());
+		std::string expect[] = {"a","ab","abc","bcd","cde","def"};
+		for (int i = 0;i < 6;i++)
+		{
+			CHECK(w.enqueue(std::string(1,static_cast<char>('a' + i))));
+			CHECK(w.aggregate() == expect[i]);
+		}
+		CHECK(w.dropped() == 3);
+
+		// Switching to reject keeps the window and refuses the next sample.
+		w.set_overflow_mode(std::circular_overflow::reject);
+		CHECK(w.overflow_mode() == std::circular_overflow::reject);
+		CHECK(!w.enqueue("g"));
+		CHECK(w.aggregate() == "def");
+		CHECK(w.dequeue());
+		CHECK(w.aggregate() == "ef");
+		CHECK(w.enqueue("g"));
+		CHECK(w.aggregate() == "efg");
+		CHECK(w.dropped() == 3);
+		CHECK(w.getcapacity() == 3);
+	}
+}
+
+int main()
+{
+	test_models();
+	test_sliding_window();
+	return 0;
+}
@@ -0,0 +1,117 @@
+#include <concurrent_circular_queue>
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "check.h"
+
+// work_stealing_deque: LIFO for the owner and FIFO for thieves, growth from a
+// tiny ring while thieves are reading it, and an owner racing several thieves
+// with every item taken exactly once.
+
+namespace
+{
+	void test_single_thread()
+	{
+		CHECK_THROWS(std::work_stealing_deque<int>(0),std::invalid_argument);
+		std::work_stealing_deque<int> d(2);
+		int v = 0;
+		CHECK(!d.pop(v));
+		CHECK(!d.try_steal(v));
+		CHECK(!d.steal(v));
+		for (int i = 0;i < 10;i++) d.push(i);
+		CHECK(d.size() == 10);
+		CHECK(d.getcapacity() >= 10);
+		CHECK(d.pop(v) && v == 9);
+		CHECK(d.steal(v) && v == 0);
+		CHECK(d.try_steal(v) && v == 1);
+		CHECK(d.pop(v) && v == 8);
+		for (int expect = 7;expect >= 2;expect--) CHECK(d.pop(v) && v == expect);
+		CHECK(!d.pop(v));
+		CHECK(d.isEmpty());
+		d.push(42);
+		CHECK(d.steal(v) && v == 42);
+		CHECK(!d.pop(v));
+	}
+
+	void test_stress(unsigned thieves,uint64_t items,unsigned seed)
+	{
+		std::work_stealing_deque<uint64_t,std::circular_queue_atomic_stats> d(2);
+		std::atomic<bool> done(false);
+		std::vector<std::vector<uint64_t> > stolen(thieves);
+		std::vector<std::thread> threads;
+		for (unsigned i = 0;i < thieves;i++)
+		{
+			threads.emplace_back([&d,&done,&stolen,i]
+			{
+				for (;;)
+				{
+					uint64_t v;
+					if (d.try_steal(v))
+					{
+						// The top only moves up, so one thief sees ids rising.
+						CHECK(stolen[i].empty() || v > stolen[i].back());
+						stolen[i].push_back(v);
+					}
+					else if (done.load(std::memory_order_acquire) && d.isEmpty()) break;
+					else std::this_thread::yield();
+				}
+			});
+		}
+
+		// The owner pushes ids in order and pops in random bursts; what it pops
+		// is always the newest id it still holds, because thieves only take from
+		// the old end.
+		std::mt19937 gen(seed);
+		std::vector<uint64_t> held;
+		std::vector<uint64_t> popped;
+		for (uint64_t next = 0;next < items;)
+		{
+			unsigned burst = gen() % 64;
+			for (unsigned i = 0;i < burst && next < items;i++)
+			{
+				d.push(next);
+				held.push_back(next++);
+			}
+			unsigned pops = gen() % 48;
+			for (unsigned i = 0;i < pops;i++)
+			{
+				uint64_t v;
+				if (!d.pop(v)) break;
+				CHECK(!held.empty() && v == held.back());
+				held.pop_back();
+				popped.push_back(v);
+			}
+			// Whatever the thieves took is below everything the owner still holds.
+			while (!held.empty() && held.size() > d.size() + 1) held.erase(held.begin());
+		}
+		uint64_t v;
+		while (d.pop(v)) popped.push_back(v);
+		done.store(true,std::memory_order_release);
+		for (std::thread& t : threads) t.join();
+		CHECK(d.isEmpty());
+		CHECK(d.getcapacity() >= 64);
+
+		std::vector<unsigned char> seen(items,0);
+		for (uint64_t p : popped) seen[p]++;
+		for (const std::vector<uint64_t>& s : stolen)
+			for (uint64_t p : s) seen[p]++;
+		for (unsigned char c : seen) CHECK(c == 1);
+		std::circular_queue_stats s = d.stats();
+		CHECK(s.enqueues == items);
+		CHECK(s.dequeues == items);
+		CHECK(s.allocations > 1);
+	}
+}
+
+int main()
+{
+	test_single_thread();
+	test_stress(1,200000,1);
+	test_stress(3,200000,2);
+	test_stress(8,100000,3);
+	return 0;
+}